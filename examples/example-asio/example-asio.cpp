@@ -28,81 +28,43 @@
   SOFTWARE.
 **/
 
-#include <array>
 #include <chrono>
-#include <iostream>
 #include <string>
-#include <system_error>
 
 #include <asio.hpp>
 
 #include <continuable/continuable.hpp>
+#include <continuable/external/asio.hpp>
 
 using namespace std::chrono_literals;
 
-struct functional_io_service : asio::io_service {
-  asio::ip::udp::resolver resolver_;
-
-  functional_io_service() : resolver_(*this) {
-  }
-
-  auto post() const noexcept {
-    return [this](auto&& work) {
-      asio::io_service::post(std::forward<decltype(work)>(work));
-    };
-  }
-
-  auto wait_async(std::chrono::milliseconds /*time*/) {
-    return cti::make_continuable<void>([](auto&& promise) {
-      // ...
-      promise.set_value();
-    });
-  }
-
-  template <typename Protocol>
-  auto async_resolve(Protocol&& protocol, std::string host,
-                     std::string service) {
-    using asio::ip::udp;
-
-    return cti::make_continuable<udp::resolver::iterator>([
-      this, protocol = std::forward<Protocol>(protocol), host = std::move(host),
-      service = std::move(service)
-    ](auto&& promise) mutable {
-      resolver_.async_resolve(
-          host, service,
-          [promise = std::forward<decltype(promise)>(promise)](
-              std::error_code const& error,
-              udp::resolver::iterator iterator) mutable {
-
-            if (error) {
-              promise.set_exception(
-                  std::error_condition(error.value(), error.category()));
-            } else {
-              promise.set_value(std::move(iterator));
-            }
-          });
-    });
-  }
-};
-
 int main(int, char**) {
   using asio::ip::udp;
 
-  functional_io_service service;
-
-  service.async_resolve(udp::v4(), "127.0.0.1", "daytime")
-      .then([](udp::resolver::iterator iterator) {
+  asio::io_context context;
+  udp::resolver resolver(context);
+  asio::steady_timer timer(context);
+
+  // The completion token makes the initiating functions return
+  // a continuable, errors are passed to the error handler.
+  timer.expires_after(10ms);
+  timer.async_wait(cti::use_continuable)
+      .then([&] {
+        return resolver.async_resolve(udp::v4(), "127.0.0.1", "daytime",
+                                      cti::use_continuable);
+      })
+      .then([](udp::resolver::results_type results) {
         // ...
-        return *iterator;
+        return *results.begin();
       })
       .then([](udp::endpoint /*endpoint*/) {
-        // auto socket = std::make_shared<udp::socket>(service);
+        // auto socket = std::make_shared<udp::socket>(context);
         // socket->async_send_to()
       })
       .fail([](cti::error_type /*error*/) {
         // ...
       });
 
-  service.run();
+  context.run();
   return 0;
 }
@@ -527,11 +527,11 @@ public:
     return std::move(*this);
   }
 
-#ifdef CONTINUABLE_HAS_EXPERIMENTAL_COROUTINE
+#ifdef CONTINUABLE_HAS_COROUTINE
   auto operator co_await() && {
-    return detail::awaiting::create_awaiter(std::move(*this).materialize());
+    return detail::awaiting::create_awaiter(std::move(*this));
   }
-#endif // CONTINUABLE_HAS_EXPERIMENTAL_COROUTINE
+#endif // CONTINUABLE_HAS_COROUTINE
 
 private:
   void release() noexcept {
@@ -689,6 +689,10 @@ using detail::types::dispatch_error_tag;
 /// By default this type deduces to `std::exception_ptr`.
 /// If `CONTINUABLE_WITH_NO_EXCEPTIONS` is defined the type
 /// will be a `std::error_condition`.
+/// If `CONTINUABLE_WITH_HYBRID_ERROR_TYPE` is defined the type
+/// carries either a `std::error_code` or a `std::exception_ptr`,
+/// which makes it possible to fail with an error code without creating
+/// an exception. It is implicitly convertible to a `std::exception_ptr`.
 /// A custom error type may be set through
 /// defining `CONTINUABLE_WITH_CUSTOM_ERROR_TYPE`.
 ///
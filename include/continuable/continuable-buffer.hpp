@@ -0,0 +1,304 @@
+
+/*
+
+                        /~` _  _ _|_. _     _ |_ | _
+                        \_,(_)| | | || ||_|(_||_)|(/_
+
+                    https://github.com/Naios/continuable
+                                   v2.0.0
+
+  Copyright(c) 2015 - 2018 Denis Blank <denis.blank at outlook dot com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files(the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions :
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+**/
+
+#ifndef CONTINUABLE_BUFFER_HPP_INCLUDED__
+#define CONTINUABLE_BUFFER_HPP_INCLUDED__
+
+#include <cassert>
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <string>
+#include <utility>
+#include <vector>
+
+#if defined(__unix__)
+#include <sys/uio.h>
+#endif // __unix__
+
+#include <continuable/detail/buffer.hpp>
+
+namespace cti {
+/// Provides asynchronous I/O facilities which return continuables
+namespace io {
+/// A view onto a contiguous range of bytes which doesn't own the bytes
+///
+/// \since version 2.0.0
+class span {
+  char const* data_ = nullptr;
+  std::size_t size_ = 0U;
+
+public:
+  constexpr span() noexcept = default;
+  constexpr span(char const* data, std::size_t size) noexcept
+      : data_(data), size_(size) {
+  }
+
+  /// Returns the first byte of the view
+  constexpr char const* data() const noexcept {
+    return data_;
+  }
+  /// Returns the count of bytes of the view
+  constexpr std::size_t size() const noexcept {
+    return size_;
+  }
+  /// Returns true when the view contains no bytes
+  constexpr bool empty() const noexcept {
+    return size_ == 0U;
+  }
+
+  constexpr char const* begin() const noexcept {
+    return data_;
+  }
+  constexpr char const* end() const noexcept {
+    return data_ + size_;
+  }
+};
+
+/// A chain of reference counted byte segments, which represents
+/// a contiguous payload without storing it contiguously:
+/// ```cpp
+/// cti::io::buffer_chain message = cti::io::buffer_chain::adopt(header);
+/// message.append(std::move(body));
+///
+/// reactor.async_write(fd, std::move(message))
+///   .then([](std::size_t written) {
+///     // ...
+///   });
+/// ```
+///
+/// Chains are cheap to move and copying a chain only shares the segments,
+/// so passing a chain through continuations or compositions never copies
+/// the payload. Appending, splitting and slicing a chain is O(segments),
+/// and the segments are written through `writev` as they are.
+///
+/// The segments are immutable once they are part of a chain,
+/// bytes are only copied by copy() and to_string().
+///
+/// \since version 2.0.0
+class buffer_chain {
+  std::vector<detail::buffer::slice> slices_;
+  std::size_t size_ = 0U;
+
+  friend class reactor;
+
+public:
+  buffer_chain() = default;
+
+  /// Creates a chain of a single segment which holds a copy of the bytes
+  static buffer_chain copy(span bytes) {
+    buffer_chain chain;
+    if (!bytes.empty()) {
+      char* data;
+      detail::buffer::segment_ref owner = allocate(bytes.size(), data);
+      std::memcpy(data, bytes.data(), bytes.size());
+      chain.push_back(std::move(owner), data, bytes.size());
+    }
+    return chain;
+  }
+
+  /// Creates a chain of a single segment which takes the ownership
+  /// of the string, so its bytes aren't copied.
+  static buffer_chain adopt(std::string bytes) {
+    buffer_chain chain;
+    if (!bytes.empty()) {
+      using segment_t = detail::buffer::adopted_segment<std::string>;
+      segment_t* const segment = new segment_t(std::move(bytes));
+      std::string& adopted = segment->container();
+      chain.push_back(detail::buffer::segment_ref(segment), &adopted[0],
+                      adopted.size());
+    }
+    return chain;
+  }
+
+  /// Returns the count of bytes in the chain
+  std::size_t size() const noexcept {
+    return size_;
+  }
+  /// Returns true when the chain contains no bytes
+  bool empty() const noexcept {
+    return size_ == 0U;
+  }
+
+  /// Returns the count of segments in the chain
+  std::size_t segment_count() const noexcept {
+    return slices_.size();
+  }
+  /// Returns the bytes of the segment at the given index
+  span segment(std::size_t index) const noexcept {
+    assert(index < slices_.size() && "The index is out of range!");
+    return span(slices_[index].data, slices_[index].size);
+  }
+
+  /// Appends the segments of the given chain, which are shared
+  ///
+  /// The chain may be appended to itself.
+  void append(buffer_chain const& chain) {
+    // The segments are copied by index since the source is invalidated
+    // through the insertion when the chain is appended to itself.
+    std::size_t const count = chain.slices_.size();
+    slices_.reserve(slices_.size() + count);
+    for (std::size_t i = 0U; i < count; ++i) {
+      slices_.push_back(chain.slices_[i]);
+    }
+    size_ += chain.size_;
+  }
+  /// Appends the segments of the given chain
+  void append(buffer_chain&& chain) {
+    if (&chain == this) {
+      append(static_cast<buffer_chain const&>(chain));
+      return;
+    }
+    if (slices_.empty()) {
+      *this = std::move(chain);
+      return;
+    }
+    slices_.insert(slices_.end(),
+                   std::make_move_iterator(chain.slices_.begin()),
+                   std::make_move_iterator(chain.slices_.end()));
+    size_ += chain.size_;
+    chain.clear();
+  }
+
+  /// Removes the first `count` bytes from the chain and returns them
+  buffer_chain split(std::size_t count) {
+    assert(count <= size_ && "The count is out of range!");
+    buffer_chain front;
+    auto itr = slices_.begin();
+    for (; (itr != slices_.end()) && (count - front.size_ >= itr->size);
+         ++itr) {
+      front.size_ += itr->size;
+    }
+    front.slices_.assign(std::make_move_iterator(slices_.begin()),
+                         std::make_move_iterator(itr));
+    slices_.erase(slices_.begin(), itr);
+
+    // The segment at the boundary is shared by both chains
+    std::size_t const left = count - front.size_;
+    if (left) {
+      detail::buffer::slice& boundary = slices_.front();
+      front.push_back(boundary.owner, boundary.data, left);
+      boundary.data += left;
+      boundary.size -= left;
+    }
+    size_ -= count;
+    return front;
+  }
+
+  /// Returns a chain which shares the given range of bytes
+  buffer_chain slice(std::size_t offset, std::size_t count) const {
+    assert(offset + count <= size_ && "The range is out of bounds!");
+    buffer_chain result;
+    for (auto const& current : slices_) {
+      if (!count) {
+        break;
+      }
+      if (offset >= current.size) {
+        offset -= current.size;
+        continue;
+      }
+
+      std::size_t const size =
+          (current.size - offset < count) ? current.size - offset : count;
+      result.push_back(current.owner, current.data + offset, size);
+      count -= size;
+      offset = 0U;
+    }
+    return result;
+  }
+
+  /// Drops the first `count` bytes of the chain
+  void consume(std::size_t count) {
+    assert(count <= size_ && "The count is out of range!");
+    auto itr = slices_.begin();
+    std::size_t left = count;
+    for (; (itr != slices_.end()) && (left >= itr->size); ++itr) {
+      left -= itr->size;
+    }
+    slices_.erase(slices_.begin(), itr);
+    if (left) {
+      slices_.front().data += left;
+      slices_.front().size -= left;
+    }
+    size_ -= count;
+  }
+
+  /// Removes all segments from the chain
+  void clear() noexcept {
+    slices_.clear();
+    size_ = 0U;
+  }
+
+  /// Returns a contiguous copy of the bytes in the chain
+  std::string to_string() const {
+    std::string result;
+    result.reserve(size_);
+    for (auto const& current : slices_) {
+      result.append(current.data, current.size);
+    }
+    return result;
+  }
+
+#if defined(__unix__)
+  /// Fills the I/O vectors with up to `count` leading segments of the chain
+  /// and returns the count of filled vectors, usable with `writev`.
+  std::size_t gather(iovec* vectors, std::size_t count) const noexcept {
+    std::size_t filled = 0U;
+    for (; (filled < count) && (filled < slices_.size()); ++filled) {
+      vectors[filled].iov_base = slices_[filled].data;
+      vectors[filled].iov_len = slices_[filled].size;
+    }
+    return filled;
+  }
+#endif // __unix__
+
+private:
+  /// Allocates a segment of the given size whose bytes are writable through
+  /// the given pointer until it is part of a chain.
+  static detail::buffer::segment_ref allocate(std::size_t size, char*& data) {
+    detail::buffer::heap_segment* const segment =
+        detail::buffer::heap_segment::allocate(size);
+    data = segment->data();
+    return detail::buffer::segment_ref(segment);
+  }
+
+  /// Appends the range of bytes inside of the owning segment
+  void push_back(detail::buffer::segment_ref owner, char* data,
+                 std::size_t size) {
+    if (size) {
+      slices_.push_back({std::move(owner), data, size});
+      size_ += size;
+    }
+  }
+};
+} // namespace io
+} // namespace cti
+
+#endif // CONTINUABLE_BUFFER_HPP_INCLUDED__
@@ -0,0 +1,134 @@
+
+/*
+
+                        /~` _  _ _|_. _     _ |_ | _
+                        \_,(_)| | | || ||_|(_||_)|(/_
+
+                    https://github.com/Naios/continuable
+                                   v2.0.0
+
+  Copyright(c) 2015 - 2018 Denis Blank <denis.blank at outlook dot com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files(the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions :
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+**/
+
+#ifndef CONTINUABLE_COROUTINE_HPP_INCLUDED__
+#define CONTINUABLE_COROUTINE_HPP_INCLUDED__
+
+#include <type_traits>
+#include <utility>
+
+#include <continuable/continuable-api.hpp>
+#include <continuable/continuable-base.hpp>
+#include <continuable/continuable-types.hpp>
+#include <continuable/detail/awaiting.hpp>
+#include <continuable/detail/features.hpp>
+#include <continuable/detail/hints.hpp>
+
+// Exlude this header when coroutines are not available
+#ifdef CONTINUABLE_HAS_COROUTINE
+
+namespace cti {
+/// Returns an awaitable object which continues the current coroutine
+/// on the given executor:
+/// ```cpp
+/// cti::continuable<> process(thread_pool& pool) {
+///   // Runs on the current thread
+///   co_await cti::on([&](auto&& work) {
+///     pool.post(std::forward<decltype(work)>(work));
+///   });
+///   // Runs on the thread pool
+/// }
+/// ```
+///
+/// \param executor The executor which is invoked with the work to
+///        resume the coroutine. The work is the coroutine handle itself,
+///        which is invocable through its `operator()`, copyable and
+///        as small as a pointer, so no allocation is required to
+///        erase it.
+///
+/// \since version 2.0.0
+template <typename Executor>
+auto on(Executor&& executor) {
+  return detail::awaiting::executor_awaitable<std::decay_t<Executor>>(
+      std::forward<Executor>(executor));
+}
+
+/// Returns an awaitable object which returns the result of the given
+/// continuable as expected object from `co_await`, so errors are returned
+/// as value instead of being thrown:
+/// ```cpp
+/// auto result = co_await cti::as_expected(http_request("github.com"));
+/// if (result.is_value()) {
+///   std::string response = std::move(result.get_value());
+/// } else {
+///   cti::error_type error = result.get_exception();
+/// }
+/// ```
+///
+/// This makes it possible to handle errors of awaited continuables
+/// when exceptions are disabled, the value of the expected object depends
+/// on the result type like for cti::transforms::wait().
+///
+/// \since version 2.0.0
+template <typename Data, typename Annotation>
+auto as_expected(continuable_base<Data, Annotation>&& continuable) {
+  return detail::awaiting::create_expected_awaiter(std::move(continuable));
+}
+} // namespace cti
+
+#if defined(CONTINUABLE_HAS_EXPERIMENTAL_COROUTINE)
+namespace std {
+namespace experimental {
+#else  // CONTINUABLE_HAS_EXPERIMENTAL_COROUTINE
+namespace std {
+#endif // CONTINUABLE_HAS_EXPERIMENTAL_COROUTINE
+/// Makes it possible to return a continuable from a coroutine:
+/// ```cpp
+/// cti::continuable<int> get_answer() {
+///   int answer = co_await http_request("github.com").then([] {
+///     return 42;
+///   });
+///   co_return answer;
+/// }
+/// ```
+///
+/// The coroutine is started lazily when the continuable is invoked.
+///
+/// \since version 2.0.0
+template <typename Data, typename... Args, typename... FunctionArgs>
+struct coroutine_traits<
+    cti::continuable_base<Data,
+                          cti::detail::hints::signature_hint_tag<Args...>>,
+    FunctionArgs...> {
+
+  using promise_type = cti::detail::awaiting::promise_type<
+      cti::continuable_base<Data,
+                            cti::detail::hints::signature_hint_tag<Args...>>,
+      cti::promise<Args...>, Args...>;
+};
+#if defined(CONTINUABLE_HAS_EXPERIMENTAL_COROUTINE)
+} // namespace experimental
+} // namespace std
+#else  // CONTINUABLE_HAS_EXPERIMENTAL_COROUTINE
+} // namespace std
+#endif // CONTINUABLE_HAS_EXPERIMENTAL_COROUTINE
+
+#endif // CONTINUABLE_HAS_COROUTINE
+#endif // CONTINUABLE_COROUTINE_HPP_INCLUDED__
@@ -0,0 +1,204 @@
+
+/*
+
+                        /~` _  _ _|_. _     _ |_ | _
+                        \_,(_)| | | || ||_|(_||_)|(/_
+
+                    https://github.com/Naios/continuable
+                                   v2.0.0
+
+  Copyright(c) 2015 - 2018 Denis Blank <denis.blank at outlook dot com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files(the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions :
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+**/
+
+#ifndef CONTINUABLE_DATAGRAM_HPP_INCLUDED__
+#define CONTINUABLE_DATAGRAM_HPP_INCLUDED__
+
+#include <continuable/detail/features.hpp>
+
+// Exlude this header when the reactor isn't available,
+// since recvmmsg and sendmmsg are Linux specific.
+#ifdef CONTINUABLE_HAS_EPOLL
+
+#include <cassert>
+#include <cstddef>
+#include <cstring>
+#include <vector>
+
+#include <sys/socket.h>
+#include <sys/uio.h>
+
+#include <continuable/continuable-buffer.hpp>
+
+namespace cti {
+/// Provides asynchronous I/O facilities which return continuables
+namespace io {
+/// A datagram of a datagram_batch
+///
+/// \since version 2.0.0
+class datagram {
+  mmsghdr const* header_;
+
+public:
+  explicit datagram(mmsghdr const* header) noexcept : header_(header) {
+  }
+
+  /// Returns the payload of the datagram
+  span data() const noexcept {
+    return span(static_cast<char const*>(header_->msg_hdr.msg_iov->iov_base),
+                header_->msg_len);
+  }
+  /// Returns the address of the peer
+  sockaddr const* address() const noexcept {
+    return static_cast<sockaddr const*>(header_->msg_hdr.msg_name);
+  }
+  /// Returns the size of the address of the peer
+  socklen_t address_size() const noexcept {
+    return header_->msg_hdr.msg_namelen;
+  }
+  /// Returns true when the payload was longer than the buffer
+  /// of the batch and was truncated.
+  bool truncated() const noexcept {
+    return (header_->msg_hdr.msg_flags & MSG_TRUNC) != 0;
+  }
+};
+
+/// A batch of datagrams which is received through a single `recvmmsg`
+/// or sent through a single `sendmmsg` by the io::reactor:
+/// ```cpp
+/// cti::io::datagram_batch batch(64);
+///
+/// reactor.async_receive_batch(fd, batch)
+///   .then([&](std::size_t count) {
+///     for (std::size_t i = 0; i < count; ++i) {
+///       cti::io::span payload = batch[i].data();
+///       // ...
+///     }
+///   });
+/// ```
+///
+/// The batch owns the buffers for received datagrams, all buffers and
+/// headers are allocated once on construction and reused for every batch.
+/// Datagrams which are pushed for sending refer to the given payload
+/// without copying it.
+///
+/// \attention A batch can only be used by one operation at the same time,
+///            and pushed payloads must stay valid until they were sent.
+///
+/// \since version 2.0.0
+class datagram_batch {
+  std::size_t datagram_size_;
+  std::vector<char> storage_;
+  std::vector<iovec> vectors_;
+  std::vector<sockaddr_storage> addresses_;
+  std::vector<mmsghdr> headers_;
+  std::size_t size_ = 0U;
+
+  friend class reactor;
+
+public:
+  /// The default size of the buffer per received datagram
+  static constexpr std::size_t default_datagram_size = 2048U;
+
+  /// Creates a batch for up to `capacity` datagrams, every received
+  /// datagram is truncated to `datagram_size` bytes.
+  explicit datagram_batch(std::size_t capacity,
+                          std::size_t datagram_size = default_datagram_size)
+      : datagram_size_(datagram_size), storage_(capacity * datagram_size),
+        vectors_(capacity), addresses_(capacity), headers_(capacity) {
+    assert(capacity && "The batch requires a capacity!");
+  }
+
+  /// Returns the maximal count of datagrams
+  std::size_t capacity() const noexcept {
+    return headers_.size();
+  }
+  /// Returns the count of datagrams which were received or pushed
+  std::size_t size() const noexcept {
+    return size_;
+  }
+  /// Returns true when no datagram was received or pushed
+  bool empty() const noexcept {
+    return size_ == 0U;
+  }
+
+  /// Returns the datagram at the given index
+  datagram operator[](std::size_t index) const noexcept {
+    assert(index < size_ && "The index is out of range!");
+    return datagram(&headers_[index]);
+  }
+
+  /// Removes all datagrams from the batch
+  void clear() noexcept {
+    size_ = 0U;
+  }
+
+  /// Adds a datagram for sending to the given address,
+  /// returns false when the batch is full.
+  bool push(span payload, sockaddr const* address, socklen_t address_size) {
+    if (size_ == capacity()) {
+      return false;
+    }
+    assert(address_size <= sizeof(sockaddr_storage));
+
+    vectors_[size_].iov_base = const_cast<char*>(payload.data());
+    vectors_[size_].iov_len = payload.size();
+    if (address) {
+      std::memcpy(&addresses_[size_], address, address_size);
+    }
+    reset(size_, address ? address_size : 0U);
+    headers_[size_].msg_len = static_cast<unsigned>(payload.size());
+    ++size_;
+    return true;
+  }
+  /// Adds a datagram for sending over a connected socket,
+  /// returns false when the batch is full.
+  bool push(span payload) {
+    return push(payload, nullptr, 0U);
+  }
+
+private:
+  void reset(std::size_t index, socklen_t address_size) noexcept {
+    msghdr& header = headers_[index].msg_hdr;
+    header.msg_name = address_size ? &addresses_[index] : nullptr;
+    header.msg_namelen = address_size;
+    header.msg_iov = &vectors_[index];
+    header.msg_iovlen = 1U;
+    header.msg_control = nullptr;
+    header.msg_controllen = 0U;
+    header.msg_flags = 0;
+  }
+
+  /// Points the headers to the owned buffers before receiving
+  mmsghdr* prepare_receive() noexcept {
+    size_ = 0U;
+    for (std::size_t i = 0; i < capacity(); ++i) {
+      vectors_[i].iov_base = storage_.data() + i * datagram_size_;
+      vectors_[i].iov_len = datagram_size_;
+      reset(i, sizeof(sockaddr_storage));
+    }
+    return headers_.data();
+  }
+};
+} // namespace io
+} // namespace cti
+
+#endif // CONTINUABLE_HAS_EPOLL
+#endif // CONTINUABLE_DATAGRAM_HPP_INCLUDED__
@@ -0,0 +1,488 @@
+
+/*
+
+                        /~` _  _ _|_. _     _ |_ | _
+                        \_,(_)| | | || ||_|(_||_)|(/_
+
+                    https://github.com/Naios/continuable
+                                   v2.0.0
+
+  Copyright(c) 2015 - 2018 Denis Blank <denis.blank at outlook dot com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files(the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions :
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+**/
+
+#ifndef CONTINUABLE_DIRECTORY_HPP_INCLUDED__
+#define CONTINUABLE_DIRECTORY_HPP_INCLUDED__
+
+#include <continuable/detail/features.hpp>
+
+// Exlude this header when getdents64 isn't available
+#ifdef CONTINUABLE_HAS_GETDENTS
+
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <dirent.h>
+#include <sys/stat.h>
+
+#include <continuable/continuable-base.hpp>
+#include <continuable/continuable-promise-base.hpp>
+#include <continuable/continuable-types.hpp>
+#include <continuable/detail/directory.hpp>
+#include <continuable/detail/hints.hpp>
+#include <continuable/detail/io.hpp>
+#include <continuable/detail/types.hpp>
+
+namespace cti {
+/// Provides asynchronous I/O facilities which return continuables
+namespace io {
+/// Configures a walk through a directory tree
+///
+/// \since version 2.0.0
+struct walk_options {
+  /// The maximal count of directories which are read concurrently
+  std::size_t concurrency = 4U;
+  /// Retrieves the status of every entry when true
+  bool status = false;
+};
+
+/// An entry which was found by the directory walker
+///
+/// \since version 2.0.0
+struct directory_entry {
+  /// The path of the entry, which starts with the path of the walked root
+  std::string path;
+  /// The type of the entry (`DT_*`)
+  unsigned char type;
+  /// The inode of the entry
+  std::uint64_t inode;
+  /// The status of the entry, which is only present when it was requested
+  /// and the status_error is zero.
+  struct stat status;
+  /// The `errno` value of the failed status retrieval, zero otherwise
+  int status_error;
+};
+
+/// Walks a directory tree recursively and yields its entries as a stream
+/// of batches:
+/// ```cpp
+/// cti::io::directory_walker walker("/srv/data", options, pool.executor());
+///
+/// std::function<void()> index = [&] {
+///   walker.next().then([&](std::vector<cti::io::directory_entry> entries) {
+///     if (!entries.empty()) {
+///       // ...
+///       index();
+///     }
+///   });
+/// };
+/// ```
+///
+/// Directories are read in bulk through `getdents64`, the status of the
+/// entries is retrieved through batches of `statx` operations which are
+/// submitted through io_uring where available, or through `fstatat`.
+///
+/// The directories are read through the given executor, where up to
+/// walk_options::concurrency directories are in flight at once, which
+/// makes it possible to read many directories in parallel on a thread
+/// pool. Without an executor the directories are read by the thread which
+/// requests the entries. The walk pauses while as many batches are
+/// buffered as directories may be in flight, which bounds the memory usage
+/// when the consumer is slower than the walk.
+///
+/// Every batch contains the entries of one chunk of a directory,
+/// the order of the batches is unspecified and an empty batch marks the
+/// end of the walk. Symbolic links are reported but never followed.
+/// A directory which can't be read rejects the continuable which was
+/// returned by next() with its error, the walk continues afterwards.
+///
+/// \attention Only one continuation can wait for entries at a time,
+///            which is resolved on the thread which read the entries
+///            unless an executor is passed to then().
+///
+/// \since version 2.0.0
+class directory_walker {
+  using entries_t = std::vector<directory_entry>;
+  using promise_t = promise_base<
+      detail::unique_function_adjustable<
+          64U, void(entries_t)&&,
+          void(detail::types::dispatch_error_tag,
+               detail::types::error_type)&&>,
+      detail::hints::signature_hint_tag<entries_t>>;
+  using work_t = detail::unique_function_adapter<0U, void()>;
+  using executor_t = detail::unique_function_adapter<0U, void(work_t)>;
+
+  /// The entries of a chunk of a directory, or the error of a directory
+  struct batch {
+    entries_t entries;
+    int error;
+  };
+
+  /// A directory in flight which is read chunk by chunk
+  struct reader {
+    std::string path;
+    std::string prefix;
+    detail::io::file_descriptor fd;
+    std::unique_ptr<detail::directory::status_batch> statuses;
+    std::unique_ptr<char[]> buffer;
+  };
+
+  /// The state of the walk which is shared with the directories in flight,
+  /// so the walker doesn't need to outlive them.
+  ///
+  /// Requests and finished directories are handled iteratively by the
+  /// outermost call to resume() like in the mmap::pump.
+  ///
+  /// Every chunk which is read reserves a place among the buffered
+  /// batches first, a reader which can't reserve one is parked until
+  /// step() resumes it after the consumer took a batch.
+  class walk : public std::enable_shared_from_this<walk> {
+    walk_options options_;
+    executor_t executor_;
+    std::atomic<std::size_t> requests_{0U};
+
+    std::mutex mutex_;
+    std::deque<std::string> directories_;
+    std::deque<batch> ready_;
+    /// The count of chunks which are read and not published yet
+    std::size_t reserved_ = 0U;
+    /// The readers which wait for a place among the buffered batches
+    std::deque<std::unique_ptr<reader>> parked_;
+    std::size_t in_flight_ = 0U;
+    detail::io::pending<promise_t> waiting_;
+    /// The status retrieval of the directories which aren't in flight
+    std::vector<std::unique_ptr<detail::directory::status_batch>> statuses_;
+    bool cancelled_ = false;
+
+  public:
+    walk(std::string root, walk_options options, executor_t executor)
+        : options_(options), executor_(std::move(executor)) {
+      if (!options_.concurrency) {
+        options_.concurrency = 1U;
+      }
+      directories_.push_back(std::move(root));
+    }
+
+    void request(promise_t promise) {
+      std::unique_lock<std::mutex> lock(mutex_);
+      if (waiting_.has_value() || cancelled_) {
+        int const error = cancelled_ ? ECANCELED : EALREADY;
+        lock.unlock();
+        std::move(promise).set_exception(
+            detail::io::make_system_error(error));
+        return;
+      }
+      waiting_.emplace(std::move(promise));
+      lock.unlock();
+      resume();
+    }
+
+    /// Stops the walk and rejects a waiting continuation with `ECANCELED`
+    void cancel() {
+      std::unique_lock<std::mutex> lock(mutex_);
+      cancelled_ = true;
+      directories_.clear();
+      ready_.clear();
+      in_flight_ -= parked_.size();
+      parked_.clear();
+      if (waiting_.has_value()) {
+        promise_t promise = waiting_.take();
+        lock.unlock();
+        std::move(promise).set_exception(
+            detail::io::make_system_error(ECANCELED));
+      }
+    }
+
+  private:
+    void resume() {
+      if (requests_.fetch_add(1U, std::memory_order_acq_rel) != 0U) {
+        return;
+      }
+      do {
+        step();
+      } while (requests_.fetch_sub(1U, std::memory_order_acq_rel) != 1U);
+    }
+
+    /// Resolves the waiting continuation and starts further directories
+    void step() {
+      std::unique_lock<std::mutex> lock(mutex_);
+      bool const finished =
+          directories_.empty() && ready_.empty() && !in_flight_;
+      if (waiting_.has_value() && (!ready_.empty() || finished)) {
+        promise_t promise = waiting_.take();
+        batch current{entries_t(), 0};
+        if (!ready_.empty()) {
+          current = std::move(ready_.front());
+          ready_.pop_front();
+        }
+        lock.unlock();
+
+        if (current.error) {
+          std::move(promise).set_exception(
+              detail::io::make_system_error(current.error));
+        } else {
+          std::move(promise).set_value(std::move(current.entries));
+        }
+        lock.lock();
+      }
+
+      std::vector<std::unique_ptr<reader>> started;
+      while (!cancelled_ && !parked_.empty() && has_place()) {
+        started.push_back(std::move(parked_.front()));
+        parked_.pop_front();
+        ++reserved_;
+      }
+      while (!cancelled_ && !directories_.empty() &&
+             (in_flight_ < options_.concurrency) && has_place()) {
+        std::unique_ptr<reader> current(new reader());
+        current->path = std::move(directories_.front());
+        directories_.pop_front();
+        started.push_back(std::move(current));
+        ++in_flight_;
+        ++reserved_;
+      }
+      lock.unlock();
+
+      for (std::unique_ptr<reader>& current : started) {
+        auto self = this->shared_from_this();
+        executor_(work_t([self, current = std::move(current)]() mutable {
+          self->read(std::move(current));
+          self->resume();
+        }));
+      }
+    }
+
+    /// Returns true when a further chunk may be read without exceeding
+    /// the bound of the buffered batches.
+    bool has_place() const noexcept {
+      return (ready_.size() + reserved_) < options_.concurrency;
+    }
+
+    /// Reserves a place for the next chunk of the given reader, or parks
+    /// the reader when there is none. Returns false when the reader
+    /// was parked or the walk was cancelled.
+    bool reserve(std::unique_ptr<reader>& current) {
+      std::unique_lock<std::mutex> lock(mutex_);
+      if (cancelled_) {
+        --in_flight_;
+        lock.unlock();
+        current.reset();
+        return false;
+      }
+      if (!has_place()) {
+        parked_.push_back(std::move(current));
+        return false;
+      }
+      ++reserved_;
+      return true;
+    }
+
+    /// Reads the directory chunk by chunk and publishes every chunk,
+    /// the place of the first chunk was reserved by the caller already.
+    void read(std::unique_ptr<reader> current) {
+      if (!current->buffer) {
+        int error = 0;
+        current->fd =
+            detail::directory::open_directory(current->path.c_str(), error);
+        if (!current->fd) {
+          publish(batch{entries_t(), error}, std::vector<std::string>());
+          finish(nullptr);
+          return;
+        }
+
+        current->prefix = current->path;
+        if (current->prefix.empty() || (current->prefix.back() != '/')) {
+          current->prefix.push_back('/');
+        }
+        if (options_.status) {
+          current->statuses = acquire();
+        }
+        current->buffer.reset(new char[detail::directory::buffer_size]);
+      }
+
+      std::string const& prefix = current->prefix;
+      detail::directory::status_batch* const statuses =
+          current->statuses.get();
+
+      for (;;) {
+        long const size = detail::directory::read_entries(
+            current->fd.get(), current->buffer.get(),
+            detail::directory::buffer_size);
+        if (size <= 0) {
+          // Releases the reserved place and publishes the error if any
+          publish(batch{entries_t(), static_cast<int>(-size)},
+                  std::vector<std::string>());
+          break;
+        }
+
+        entries_t entries;
+        detail::directory::for_each_entry(
+            current->buffer.get(), static_cast<std::size_t>(size),
+            [&](std::uint64_t inode, unsigned char type, char const* name,
+                std::size_t length) {
+              directory_entry entry{};
+              entry.path.reserve(prefix.size() + length);
+              entry.path.append(prefix).append(name, length);
+              entry.type = type;
+              entry.inode = inode;
+              entries.push_back(std::move(entry));
+            });
+        if (statuses) {
+          statuses->stat(current->fd.get(), entries.data(), entries.size(),
+                         prefix.size());
+        }
+
+        std::vector<std::string> children;
+        for (directory_entry& entry : entries) {
+          if (entry.type == DT_UNKNOWN) {
+            // Some file systems don't report the type of their entries
+            resolve_type(current->fd.get(), entry, prefix.size(),
+                         bool(statuses));
+          }
+          if (entry.type == DT_DIR) {
+            children.push_back(entry.path);
+          }
+        }
+
+        if (!publish(batch{std::move(entries), 0}, std::move(children))) {
+          break;
+        }
+        resume();
+
+        if (!reserve(current)) {
+          return;
+        }
+      }
+      finish(std::move(current->statuses));
+    }
+
+    static void resolve_type(int dirfd, directory_entry& entry,
+                             std::size_t name_offset, bool has_status) {
+      if (has_status) {
+        if (!entry.status_error) {
+          entry.type = static_cast<unsigned char>(IFTODT(entry.status.st_mode));
+        }
+        return;
+      }
+
+      struct stat status;
+      if (!detail::directory::stat_entry(
+              dirfd, entry.path.c_str() + name_offset, status)) {
+        entry.type = static_cast<unsigned char>(IFTODT(status.st_mode));
+      }
+    }
+
+    /// Queues the chunk and the subdirectories which were found in it and
+    /// releases its reserved place, returns false when the walk
+    /// was cancelled.
+    bool publish(batch current, std::vector<std::string> children) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      --reserved_;
+      if (cancelled_) {
+        return false;
+      }
+      for (std::string& child : children) {
+        directories_.push_back(std::move(child));
+      }
+      if (current.error || !current.entries.empty()) {
+        ready_.push_back(std::move(current));
+      }
+      return true;
+    }
+
+    std::unique_ptr<detail::directory::status_batch> acquire() {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (statuses_.empty()) {
+        return std::unique_ptr<detail::directory::status_batch>(
+            new detail::directory::status_batch());
+      }
+      auto statuses = std::move(statuses_.back());
+      statuses_.pop_back();
+      return statuses;
+    }
+
+    void finish(std::unique_ptr<detail::directory::status_batch> statuses) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      --in_flight_;
+      if (statuses) {
+        statuses_.push_back(std::move(statuses));
+      }
+    }
+  };
+
+  std::shared_ptr<walk> walk_;
+
+public:
+  /// Walks the directory at the given path, where the directories are
+  /// read by the thread which requests the entries.
+  explicit directory_walker(std::string root,
+                            walk_options options = walk_options())
+      : directory_walker(std::move(root), options,
+                         [](work_t work) { std::move(work)(); }) {
+  }
+  /// Walks the directory at the given path, where the directories are
+  /// read through the given executor.
+  template <typename Executor>
+  directory_walker(std::string root, walk_options options,
+                   Executor&& executor)
+      : walk_(std::make_shared<walk>(
+            std::move(root), options,
+            executor_t([executor = std::forward<Executor>(executor)](
+                           work_t work) mutable {
+              executor(std::move(work));
+            }))) {
+  }
+  /// Stops the walk, a waiting continuation is rejected with `ECANCELED`
+  ~directory_walker() {
+    if (walk_) {
+      walk_->cancel();
+    }
+  }
+
+  directory_walker(directory_walker&&) = default;
+  directory_walker& operator=(directory_walker&& right) {
+    if (walk_) {
+      walk_->cancel();
+    }
+    walk_ = std::move(right.walk_);
+    return *this;
+  }
+
+  /// Returns a continuable which resolves with the next batch of entries,
+  /// the batch is empty when the walk finished.
+  auto next() {
+    return make_continuable<entries_t>([walk = walk_](auto&& promise) {
+      walk->request(promise_t(std::forward<decltype(promise)>(promise)));
+    });
+  }
+};
+} // namespace io
+} // namespace cti
+
+#endif // CONTINUABLE_HAS_GETDENTS
+#endif // CONTINUABLE_DIRECTORY_HPP_INCLUDED__
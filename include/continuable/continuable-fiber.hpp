@@ -0,0 +1,126 @@
+
+/*
+
+                        /~` _  _ _|_. _     _ |_ | _
+                        \_,(_)| | | || ||_|(_||_)|(/_
+
+                    https://github.com/Naios/continuable
+                                   v2.0.0
+
+  Copyright(c) 2015 - 2018 Denis Blank <denis.blank at outlook dot com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files(the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions :
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+**/
+
+#ifndef CONTINUABLE_FIBER_HPP_INCLUDED__
+#define CONTINUABLE_FIBER_HPP_INCLUDED__
+
+#include <cstddef>
+#include <utility>
+
+#include <continuable/continuable-api.hpp>
+#include <continuable/continuable-base.hpp>
+#include <continuable/detail/features.hpp>
+#include <continuable/detail/fiber.hpp>
+
+// Exlude this header when fibers are not available
+#ifdef CONTINUABLE_HAS_FIBERS
+
+namespace cti {
+/// A scheduler which runs stackful fibers on the thread calling
+/// fiber_scheduler::run(). Fibers can await continuables through
+/// cti::this_fiber::await(), which parks only the fiber until the
+/// continuation was resolved, so blocking-style code can issue
+/// many concurrent requests without a thread per request:
+/// ```cpp
+/// cti::fiber_scheduler scheduler;
+///
+/// for (std::string const& url : urls) {
+///   scheduler.spawn([url] {
+///     std::string response = cti::this_fiber::await(http_request(url));
+///     // ...
+///   });
+/// }
+///
+/// scheduler.run();
+/// ```
+///
+/// Continuations may be resolved from any thread, the fiber is resumed on
+/// the thread running the scheduler then.
+///
+/// \note Fibers are available on Linux x86-64 only, which is indicated
+///       through the `CONTINUABLE_HAS_FIBERS` define.
+///
+/// \since version 2.0.0
+class fiber_scheduler {
+  detail::fiber::scheduler scheduler_;
+
+public:
+  /// The default size of the stack of every fiber,
+  /// the memory is committed lazily by the operating system.
+  static constexpr std::size_t default_stack_size = 256U * 1024U;
+
+  /// Creates a scheduler which creates fibers with the given stack size
+  explicit fiber_scheduler(std::size_t stack_size = default_stack_size)
+      : scheduler_(stack_size) {
+  }
+
+  /// Creates a fiber which runs the given callable object
+  /// when the scheduler is run.
+  template <typename T>
+  void spawn(T&& callable) {
+    scheduler_.spawn(std::forward<T>(callable));
+  }
+
+  /// Runs the fibers on the current thread until all of them finished.
+  ///
+  /// The first exception which escaped a fiber is rethrown from this
+  /// method after the remaining fibers finished.
+  void run() {
+    scheduler_.run();
+  }
+};
+
+/// Provides functions which are usable from inside a fiber
+namespace this_fiber {
+/// Parks the current fiber until the given continuable was resolved
+/// and returns its result, errors are thrown like for `co_await`.
+///
+/// \since version 2.0.0
+template <typename Data, typename Annotation>
+auto await(continuable_base<Data, Annotation>&& continuable) {
+  return detail::fiber::await(
+      detail::base::attorney::materialize(std::move(continuable)));
+}
+
+/// Parks the current fiber until the given continuable was resolved
+/// and returns its result or its error as expected object,
+/// which also works when exceptions are disabled.
+///
+/// \since version 2.0.0
+template <typename Data, typename Annotation>
+auto await_expected(continuable_base<Data, Annotation>&& continuable) {
+  return detail::fiber::await_expected(
+      detail::base::attorney::materialize(std::move(continuable)));
+}
+} // namespace this_fiber
+} // namespace cti
+
+#endif // CONTINUABLE_HAS_FIBERS
+#endif // CONTINUABLE_FIBER_HPP_INCLUDED__
@@ -0,0 +1,70 @@
+
+/*
+
+                        /~` _  _ _|_. _     _ |_ | _
+                        \_,(_)| | | || ||_|(_||_)|(/_
+
+                    https://github.com/Naios/continuable
+                                   v2.0.0
+
+  Copyright(c) 2015 - 2018 Denis Blank <denis.blank at outlook dot com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files(the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions :
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+**/
+
+#ifndef CONTINUABLE_GENERATOR_HPP_INCLUDED__
+#define CONTINUABLE_GENERATOR_HPP_INCLUDED__
+
+#include <continuable/continuable-api.hpp>
+#include <continuable/continuable-types.hpp>
+#include <continuable/detail/features.hpp>
+#include <continuable/detail/generator.hpp>
+
+// Exlude this header when coroutines are not available
+#ifdef CONTINUABLE_HAS_COROUTINE
+
+namespace cti {
+/// A coroutine which produces a stream of elements through `co_yield`,
+/// which are pulled lazily by the consumer through a continuable:
+/// ```cpp
+/// cti::async_generator<row> query(std::string statement) {
+///   auto cursor = co_await open_cursor(std::move(statement));
+///   while (auto fetched = co_await cursor.fetch()) {
+///     co_yield *fetched;
+///   }
+/// }
+///
+/// auto rows = query("SELECT * FROM users");
+/// while (row* current = co_await rows.next()) {
+///   // ...
+/// }
+/// ```
+///
+/// The continuable returned by `async_generator::next()` resolves with a
+/// pointer to the element which is stored in the frame of the generator,
+/// or a `nullptr` when the generator ended. Since elements aren't copied
+/// and the frame is reused, no allocation happens per element.
+///
+/// \since version 2.0.0
+template <typename T>
+using async_generator = detail::awaiting::async_generator<T, promise<T*>>;
+} // namespace cti
+
+#endif // CONTINUABLE_HAS_COROUTINE
+#endif // CONTINUABLE_GENERATOR_HPP_INCLUDED__
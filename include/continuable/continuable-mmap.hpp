@@ -0,0 +1,164 @@
+
+/*
+
+                        /~` _  _ _|_. _     _ |_ | _
+                        \_,(_)| | | || ||_|(_||_)|(/_
+
+                    https://github.com/Naios/continuable
+                                   v2.0.0
+
+  Copyright(c) 2015 - 2018 Denis Blank <denis.blank at outlook dot com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files(the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions :
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+**/
+
+#ifndef CONTINUABLE_MMAP_HPP_INCLUDED__
+#define CONTINUABLE_MMAP_HPP_INCLUDED__
+
+#include <continuable/detail/features.hpp>
+
+// Exlude this header when mmap isn't available
+#ifdef CONTINUABLE_HAS_MMAP
+
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+#include <continuable/continuable-base.hpp>
+#include <continuable/continuable-buffer.hpp>
+#include <continuable/detail/io.hpp>
+#include <continuable/detail/mmap.hpp>
+
+namespace cti {
+/// Provides asynchronous I/O facilities which return continuables
+namespace io {
+/// Reads a file in chunks through a read only memory mapping,
+/// every chunk is a span into the mapping, so no byte is copied:
+/// ```cpp
+/// cti::io::mapped_reader reader("access.log");
+///
+/// reader.for_each([](cti::io::span chunk) {
+///   // Is invoked with the next chunk when the previous stage finished,
+///   // a stage can return a continuable to delay the next chunk.
+///   return ingest(chunk);
+/// });
+/// ```
+///
+/// The file is mapped for sequential access and the chunk which follows
+/// the current one is read ahead through `madvise`, so the page faults
+/// of the next stage are mostly served from the page cache.
+///
+/// Chunks are produced on demand only: next() produces one chunk when
+/// it is invoked, and for_each() produces the next chunk only after the
+/// continuable returned by the stage was resolved, which provides
+/// backpressure from the slowest stage.
+///
+/// \attention The spans are valid as long as the reader is alive,
+///            and the reader must outlive the continuables it returned.
+///
+/// \since version 2.0.0
+class mapped_reader {
+  detail::mmap::mapping mapping_;
+  std::size_t chunk_size_;
+  std::size_t position_ = 0U;
+
+  template <typename, typename, typename, typename>
+  friend class detail::mmap::pump;
+
+public:
+  /// The default size of a chunk
+  static constexpr std::size_t default_chunk_size = 1024U * 1024U;
+
+  /// Maps the file at the given path,
+  /// throws a `std::system_error` on failure.
+  explicit mapped_reader(char const* path,
+                         std::size_t chunk_size = default_chunk_size)
+      : mapped_reader(detail::mmap::open_read_only(path).get(), chunk_size) {
+  }
+  /// Maps the file which is referred by the descriptor, the descriptor can
+  /// be closed afterwards, throws a `std::system_error` on failure.
+  explicit mapped_reader(int fd, std::size_t chunk_size = default_chunk_size)
+      : mapping_(fd), chunk_size_(chunk_size ? chunk_size : 1U) {
+    mapping_.will_need(0U, chunk_size_);
+  }
+
+  /// Returns the size of the file
+  std::size_t size() const noexcept {
+    return mapping_.size();
+  }
+  /// Returns the offset of the chunk which is produced next
+  std::size_t position() const noexcept {
+    return position_;
+  }
+
+  /// Returns a continuable which resolves with the next chunk,
+  /// the chunk is empty when the end of the file was reached.
+  auto next() {
+    return make_continuable<span>([this](auto&& promise) {
+      std::forward<decltype(promise)>(promise).set_value(this->take());
+    });
+  }
+
+  /// Invokes the stage with every chunk of the file up to its end,
+  /// and resolves the returned continuable afterwards.
+  ///
+  /// The stage can return a continuable, the next chunk is produced when it
+  /// was resolved, an error of the stage rejects the returned continuable
+  /// and stops the reading.
+  template <typename Stage>
+  auto for_each(Stage&& stage) {
+    return for_each(std::forward<Stage>(stage),
+                    detail::types::this_thread_executor_tag{});
+  }
+  /// Invokes the stage with every chunk of the file through the given
+  /// executor, see for_each(Stage&&) for details.
+  template <typename Stage, typename Executor>
+  auto for_each(Stage&& stage, Executor&& executor) {
+    return make_continuable<void>(
+        [this, stage = std::forward<Stage>(stage),
+         executor = std::forward<Executor>(executor)](auto&& promise) mutable {
+          using pump_t = detail::mmap::pump<
+              mapped_reader, std::decay_t<Stage>, std::decay_t<Executor>,
+              std::decay_t<decltype(promise)>>;
+
+          std::make_shared<pump_t>(this, std::move(stage), std::move(executor),
+                                   std::forward<decltype(promise)>(promise))
+              ->resume();
+        });
+  }
+
+private:
+  /// Returns the next chunk and reads the chunk after it ahead
+  span take() noexcept {
+    std::size_t const left = mapping_.size() - position_;
+    std::size_t const size = (left < chunk_size_) ? left : chunk_size_;
+    span const chunk(mapping_.data() + position_, size);
+    position_ += size;
+
+    if (size) {
+      mapping_.will_need(position_, chunk_size_);
+    }
+    return chunk;
+  }
+};
+} // namespace io
+} // namespace cti
+
+#endif // CONTINUABLE_HAS_MMAP
+#endif // CONTINUABLE_MMAP_HPP_INCLUDED__
@@ -0,0 +1,174 @@
+
+/*
+
+                        /~` _  _ _|_. _     _ |_ | _
+                        \_,(_)| | | || ||_|(_||_)|(/_
+
+                    https://github.com/Naios/continuable
+                                   v2.0.0
+
+  Copyright(c) 2015 - 2018 Denis Blank <denis.blank at outlook dot com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files(the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions :
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+**/
+
+#ifndef CONTINUABLE_PROCESS_HPP_INCLUDED__
+#define CONTINUABLE_PROCESS_HPP_INCLUDED__
+
+#include <continuable/detail/features.hpp>
+
+// Exlude this header when the reactor isn't available
+#ifdef CONTINUABLE_HAS_EPOLL
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <sys/types.h>
+#include <unistd.h>
+
+#include <continuable/detail/io.hpp>
+#include <continuable/detail/process.hpp>
+
+namespace cti {
+/// Provides asynchronous I/O facilities which return continuables
+namespace io {
+/// Specifies which standard streams of a child process are connected
+/// to pipes, the other streams are inherited from the parent.
+///
+/// \since version 2.0.0
+struct spawn_options {
+  bool pipe_stdin = false;
+  bool pipe_stdout = false;
+  bool pipe_stderr = false;
+};
+
+/// A child process which was started through spawn()
+///
+/// The ends of the pipes which are connected to the standard streams
+/// of the child are non-blocking, so they are usable with the
+/// asynchronous operations of the io::reactor directly.
+/// The exit status is awaited through reactor::async_wait.
+///
+/// \attention A process which is never awaited stays a zombie until
+///            the parent exits, like with `fork`.
+///
+/// \since version 2.0.0
+class process {
+  pid_t pid_ = -1;
+  detail::io::file_descriptor stdin_;
+  detail::io::file_descriptor stdout_;
+  detail::io::file_descriptor stderr_;
+
+  friend process spawn(std::vector<std::string> const& arguments,
+                       spawn_options const& options);
+
+public:
+  process() = default;
+  process(process&& right) noexcept
+      : pid_(std::exchange(right.pid_, -1)), stdin_(std::move(right.stdin_)),
+        stdout_(std::move(right.stdout_)), stderr_(std::move(right.stderr_)) {
+  }
+  process& operator=(process&& right) noexcept {
+    pid_ = std::exchange(right.pid_, -1);
+    stdin_ = std::move(right.stdin_);
+    stdout_ = std::move(right.stdout_);
+    stderr_ = std::move(right.stderr_);
+    return *this;
+  }
+
+  /// Returns the process id of the child
+  pid_t pid() const noexcept {
+    return pid_;
+  }
+
+  /// Returns the writable end of the pipe to the standard input
+  /// of the child, or -1 when it isn't piped.
+  int stdin_fd() const noexcept {
+    return stdin_.get();
+  }
+  /// Returns the readable end of the pipe from the standard output
+  /// of the child, or -1 when it isn't piped.
+  int stdout_fd() const noexcept {
+    return stdout_.get();
+  }
+  /// Returns the readable end of the pipe from the standard error
+  /// of the child, or -1 when it isn't piped.
+  int stderr_fd() const noexcept {
+    return stderr_.get();
+  }
+
+  /// Closes the pipe to the standard input, which signals the end
+  /// of the input to the child.
+  ///
+  /// \attention The descriptor needs to be released from the reactor
+  ///            before it is closed.
+  void close_stdin() noexcept {
+    stdin_ = detail::io::file_descriptor();
+  }
+};
+
+/// Starts the program which is searched in the `PATH` with the given
+/// arguments, where the first argument is the program itself,
+/// throws a `std::system_error` on failure:
+/// ```cpp
+/// cti::io::spawn_options options;
+/// options.pipe_stdout = true;
+/// cti::io::process child = cti::io::spawn({"make", "all"}, options);
+///
+/// reactor.async_wait(child).then([](int status) {
+///   // ...
+/// });
+/// ```
+///
+/// The process is started through `posix_spawn`, which doesn't copy the
+/// address space of the parent like `fork` does.
+///
+/// \since version 2.0.0
+inline process spawn(std::vector<std::string> const& arguments,
+                     spawn_options const& options = {}) {
+  detail::process::file_actions actions;
+  detail::process::pipe_ends input, output, error;
+  process child;
+
+  if (options.pipe_stdin) {
+    input = detail::process::open_pipe(false, true);
+    actions.duplicate(input.read.get(), STDIN_FILENO);
+    child.stdin_ = std::move(input.write);
+  }
+  if (options.pipe_stdout) {
+    output = detail::process::open_pipe(true, false);
+    actions.duplicate(output.write.get(), STDOUT_FILENO);
+    child.stdout_ = std::move(output.read);
+  }
+  if (options.pipe_stderr) {
+    error = detail::process::open_pipe(true, false);
+    actions.duplicate(error.write.get(), STDERR_FILENO);
+    child.stderr_ = std::move(error.read);
+  }
+
+  // The ends of the child are closed when the pipes go out of scope
+  child.pid_ = detail::process::spawn(arguments, actions);
+  return child;
+}
+} // namespace io
+} // namespace cti
+
+#endif // CONTINUABLE_HAS_EPOLL
+#endif // CONTINUABLE_PROCESS_HPP_INCLUDED__
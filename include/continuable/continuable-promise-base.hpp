@@ -76,9 +76,14 @@ public:
 
   /// Resolves the continuation with the given values
   ///
+  /// The values are forwarded by reference to the underlying callback,
+  /// so they aren't moved additionally when passing the promise.
+  ///
   /// \since version 2.0.0
-  void operator()(Args... args) && {
-    std::move(data_)(std::move(args)...);
+  template <typename... PassedArgs,
+            detail::types::enable_if_result_t<PassedArgs...>* = nullptr>
+  void operator()(PassedArgs&&... args) && {
+    std::move(data_)(std::forward<PassedArgs>(args)...);
   }
   /// Resolves the continuation with the given exception
   ///
@@ -91,8 +96,9 @@ public:
   /// Resolves the continuation with the given values
   ///
   /// \since version 2.0.0
-  void set_value(Args... args) {
-    std::move(data_)(std::move(args)...);
+  template <typename... PassedArgs>
+  void set_value(PassedArgs&&... args) {
+    std::move(data_)(std::forward<PassedArgs>(args)...);
   }
 
   /// Resolves the continuation with the given exception
@@ -0,0 +1,1011 @@
+
+/*
+
+                        /~` _  _ _|_. _     _ |_ | _
+                        \_,(_)| | | || ||_|(_||_)|(/_
+
+                    https://github.com/Naios/continuable
+                                   v2.0.0
+
+  Copyright(c) 2015 - 2018 Denis Blank <denis.blank at outlook dot com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files(the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions :
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+**/
+
+#ifndef CONTINUABLE_REACTOR_HPP_INCLUDED__
+#define CONTINUABLE_REACTOR_HPP_INCLUDED__
+
+#include <continuable/detail/features.hpp>
+
+// Exlude this header when epoll isn't available
+#ifdef CONTINUABLE_HAS_EPOLL
+
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/epoll.h>
+#include <sys/ioctl.h>
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <continuable/continuable-base.hpp>
+#include <continuable/continuable-buffer.hpp>
+#include <continuable/continuable-datagram.hpp>
+#include <continuable/continuable-process.hpp>
+#include <continuable/continuable-promise-base.hpp>
+#include <continuable/continuable-types.hpp>
+#include <continuable/detail/hints.hpp>
+#include <continuable/detail/io.hpp>
+#include <continuable/detail/process.hpp>
+#include <continuable/detail/reactor.hpp>
+#include <continuable/detail/types.hpp>
+
+namespace cti {
+/// Provides asynchronous I/O facilities which return continuables
+namespace io {
+/// An epoll based reactor which performs socket and pipe I/O
+/// asynchronously, every operation returns a continuable:
+/// ```cpp
+/// cti::io::reactor reactor;
+///
+/// reactor.async_accept(listener)
+///   .then([&](int connection) {
+///     return reactor.async_read_some(connection, buffer, sizeof(buffer));
+///   })
+///   .then([](std::size_t read) {
+///     // ...
+///   });
+///
+/// reactor.run();
+/// ```
+///
+/// Operations are attempted speculatively when the continuable is invoked,
+/// and only descriptors which would block are registered at the epoll
+/// instance. Descriptors are registered once, edge triggered for both
+/// directions, readiness is delivered in batches and resumes the pending
+/// operations directly without re-arming the descriptor.
+///
+/// The run loop doubles as an executor, which makes it possible to
+/// dispatch continuations onto the thread which runs the reactor:
+/// ```cpp
+/// http_request("example.com")
+///   .then([](std::string response) {
+///     // Is invoked on the thread which runs the reactor
+///   }, reactor.executor());
+/// ```
+///
+/// Buffer chains are written through `writev` without joining their
+/// segments, and async_read_chain reads into freshly allocated segments
+/// which can be passed on without copying them.
+///
+/// Datagram sockets are served in batches through `recvmmsg` and
+/// `sendmmsg`, so a single system call and a single continuation handle
+/// many datagrams, see datagram_batch for details.
+///
+/// Child processes which were started through io::spawn are awaited
+/// through process descriptors, and bytes are forwarded between
+/// descriptors through `splice` and `tee` without copying them
+/// into user space.
+///
+/// Failed operations are resolved with a `std::system_error`
+/// (or the error code when the hybrid error type is used).
+///
+/// \attention The descriptors must be in non-blocking mode and need to be
+///            released through release() before they are closed.
+///            Operations must be invoked from the thread which runs
+///            the reactor, only post() and stop() are thread safe.
+///            The buffers must stay valid until the operation completed.
+///
+/// \since version 2.0.0
+class reactor {
+  /// The promises which are stored per pending operation, callbacks are
+  /// stored inline up to the given capacity.
+  template <typename T>
+  using promise_of_t = promise_base<
+      detail::unique_function_adjustable<
+          64U, void(T)&&,
+          void(detail::types::dispatch_error_tag,
+               detail::types::error_type)&&>,
+      detail::hints::signature_hint_tag<T>>;
+  using work_t = detail::unique_function_adapter<0U, void()>;
+
+  struct read_operation {
+    promise_of_t<std::size_t> promise;
+    void* buffer;
+    std::size_t size;
+  };
+  struct write_operation {
+    promise_of_t<std::size_t> promise;
+    void const* buffer;
+    std::size_t size;
+    std::size_t written;
+  };
+  struct read_chain_operation {
+    promise_of_t<buffer_chain> promise;
+    std::size_t size;
+  };
+  struct write_chain_operation {
+    promise_of_t<std::size_t> promise;
+    buffer_chain chain;
+    std::size_t written;
+  };
+  struct accept_operation {
+    promise_of_t<int> promise;
+  };
+  struct receive_operation {
+    promise_of_t<std::size_t> promise;
+    datagram_batch* batch;
+  };
+  struct send_operation {
+    promise_of_t<std::size_t> promise;
+    datagram_batch* batch;
+    std::size_t sent;
+  };
+  struct exit_operation {
+    promise_of_t<int> promise;
+    pid_t pid;
+    detail::io::file_descriptor pidfd;
+  };
+  struct splice_state {
+    int from;
+    int to;
+    std::size_t size;
+    bool tee;
+    std::size_t transferred;
+  };
+  struct splice_operation {
+    promise_of_t<std::size_t> promise;
+    splice_state state;
+  };
+
+  /// The state of a registered descriptor, which is allowed to have
+  /// one pending operation of every kind.
+  struct descriptor {
+    int fd;
+    bool released = false;
+    detail::io::pending<read_operation> read;
+    detail::io::pending<accept_operation> accept;
+    detail::io::pending<write_operation> write;
+    detail::io::pending<read_chain_operation> read_chain;
+    detail::io::pending<write_chain_operation> write_chain;
+    detail::io::pending<receive_operation> receive;
+    detail::io::pending<send_operation> send;
+    detail::io::pending<exit_operation> exit;
+    /// A splice waits for the source or the destination
+    detail::io::pending<splice_operation> splice_in;
+    detail::io::pending<splice_operation> splice_out;
+
+    explicit descriptor(int fd_) : fd(fd_) {
+    }
+  };
+
+  detail::reactor::poller poller_;
+  detail::reactor::work_queue<work_t> work_;
+  std::unordered_map<int, std::unique_ptr<descriptor>> descriptors_;
+  /// Released descriptors are kept alive until the current batch of
+  /// events was processed, since the batch could still refer to them.
+  std::vector<std::unique_ptr<descriptor>> retired_;
+  std::size_t pending_ = 0U;
+  /// The maximal count of bytes which is moved per splice
+  static constexpr std::size_t splice_size = 1024U * 1024U;
+  /// The maximal count of segments which is written per `writev`
+  static constexpr std::size_t gather_size = 64U;
+  std::atomic<bool> stopped_{false};
+
+public:
+  /// Sets up the epoll instance, throws a `std::system_error` on failure.
+  reactor() = default;
+
+  /// Accepts a connection on the listening socket, resolves with the
+  /// accepted descriptor which is in non-blocking mode already.
+  auto async_accept(int fd) {
+    return make_continuable<int>([this, fd](auto&& promise) {
+      this->start_accept(fd, std::forward<decltype(promise)>(promise));
+    });
+  }
+
+  /// Reads up to `size` bytes from the descriptor into the buffer,
+  /// resolves with the count of bytes read, which is zero at the end
+  /// of the stream.
+  auto async_read_some(int fd, void* buffer, std::size_t size) {
+    return make_continuable<std::size_t>(
+        [this, fd, buffer, size](auto&& promise) {
+          this->start_read(fd, buffer, size,
+                           std::forward<decltype(promise)>(promise));
+        });
+  }
+
+  /// Writes all `size` bytes of the buffer to the descriptor,
+  /// resolves with the count of bytes written.
+  auto async_write(int fd, void const* buffer, std::size_t size) {
+    return make_continuable<std::size_t>(
+        [this, fd, buffer, size](auto&& promise) {
+          this->start_write(fd, buffer, size,
+                            std::forward<decltype(promise)>(promise));
+        });
+  }
+
+  /// Writes all bytes of the chain to the descriptor through `writev`,
+  /// resolves with the count of bytes written.
+  ///
+  /// The chain is owned by the operation, so it doesn't need to outlive it.
+  auto async_write(int fd, buffer_chain chain) {
+    return make_continuable<std::size_t>(
+        [this, fd, chain = std::move(chain)](auto&& promise) mutable {
+          this->start_write_chain(fd, std::move(chain),
+                                  std::forward<decltype(promise)>(promise));
+        });
+  }
+
+  /// Reads up to `size` bytes from the descriptor into a newly allocated
+  /// segment, resolves with a chain of the bytes read,
+  /// which is empty at the end of the stream.
+  auto async_read_chain(int fd, std::size_t size) {
+    return make_continuable<buffer_chain>([this, fd, size](auto&& promise) {
+      this->start_read_chain(fd, size,
+                             std::forward<decltype(promise)>(promise));
+    });
+  }
+
+  /// Receives a batch of datagrams through a single `recvmmsg`,
+  /// resolves with the count of datagrams which were received
+  /// into the batch.
+  auto async_receive_batch(int fd, datagram_batch& batch) {
+    return make_continuable<std::size_t>([this, fd, &batch](auto&& promise) {
+      this->start_receive(fd, batch, std::forward<decltype(promise)>(promise));
+    });
+  }
+
+  /// Sends all datagrams which were pushed into the batch through
+  /// as few `sendmmsg` calls as possible, resolves with the count of
+  /// datagrams which were sent.
+  auto async_send_batch(int fd, datagram_batch& batch) {
+    return make_continuable<std::size_t>([this, fd, &batch](auto&& promise) {
+      this->start_send(fd, batch, std::forward<decltype(promise)>(promise));
+    });
+  }
+
+  /// Waits for the exit of the child process, resolves with its exit
+  /// status, or with 128 plus the signal which terminated it.
+  ///
+  /// The exit is observed through a process descriptor (`pidfd_open`),
+  /// so no thread is blocked in `waitpid` and `SIGCHLD` isn't used.
+  auto async_wait(process const& child) {
+    return make_continuable<int>([this, pid = child.pid()](auto&& promise) {
+      this->start_wait(pid, std::forward<decltype(promise)>(promise));
+    });
+  }
+
+  /// Moves all bytes from the source to the destination descriptor until
+  /// the end of the source through `splice`, so the bytes are never copied
+  /// into user space, resolves with the count of transferred bytes.
+  ///
+  /// \attention One of the descriptors needs to be a pipe.
+  auto async_forward(int from, int to) {
+    return make_continuable<std::size_t>([this, from, to](auto&& promise) {
+      this->start_splice(splice_state{from, to, splice_size, false, 0U},
+                         std::forward<decltype(promise)>(promise));
+    });
+  }
+
+  /// Duplicates up to `size` bytes of the source pipe into the destination
+  /// pipe through `tee` without consuming them from the source,
+  /// resolves with the count of duplicated bytes.
+  ///
+  /// \attention Both descriptors need to be pipes.
+  auto async_tee(int from, int to, std::size_t size) {
+    return make_continuable<std::size_t>(
+        [this, from, to, size](auto&& promise) {
+          this->start_splice(splice_state{from, to, size, true, 0U},
+                             std::forward<decltype(promise)>(promise));
+        });
+  }
+
+  /// Unregisters the descriptor from the reactor,
+  /// its pending operations are resolved with `ECANCELED`.
+  ///
+  /// \attention Needs to be called before the descriptor is closed,
+  ///            since the descriptor number could be reused otherwise.
+  void release(int fd) {
+    auto itr = descriptors_.find(fd);
+    if (itr == descriptors_.end()) {
+      return;
+    }
+
+    std::unique_ptr<descriptor> state = std::move(itr->second);
+    descriptors_.erase(itr);
+    poller_.remove(fd);
+    state->released = true;
+    descriptor& current = *state;
+    retired_.push_back(std::move(state));
+
+    if (current.read.has_value()) {
+      cancel(current.read);
+    }
+    if (current.accept.has_value()) {
+      cancel(current.accept);
+    }
+    if (current.write.has_value()) {
+      cancel(current.write);
+    }
+    if (current.read_chain.has_value()) {
+      cancel(current.read_chain);
+    }
+    if (current.write_chain.has_value()) {
+      cancel(current.write_chain);
+    }
+    if (current.receive.has_value()) {
+      cancel(current.receive);
+    }
+    if (current.send.has_value()) {
+      cancel(current.send);
+    }
+    if (current.exit.has_value()) {
+      cancel(current.exit);
+    }
+    if (current.splice_in.has_value()) {
+      cancel(current.splice_in);
+    }
+    if (current.splice_out.has_value()) {
+      cancel(current.splice_out);
+    }
+  }
+
+  /// Queues the work for invocation on the thread which runs the reactor,
+  /// this method is thread safe.
+  template <typename Work>
+  void post(Work&& work) {
+    if (work_.push(work_t(std::forward<Work>(work)))) {
+      poller_.notify();
+    }
+  }
+
+  /// Returns an executor which posts the work to the reactor,
+  /// usable as executor argument of continuable_base::then.
+  auto executor() noexcept {
+    return [this](auto&& work) {
+      this->post(std::forward<decltype(work)>(work));
+    };
+  }
+
+  /// Resolves all operations which are ready and invokes the posted work
+  /// without blocking, returns the count of handled events and work.
+  std::size_t poll() {
+    return process(0);
+  }
+
+  /// Blocks until at least one descriptor became ready or work was posted,
+  /// returns the count of handled events and work.
+  std::size_t run_once() {
+    return process(work_.empty() ? -1 : 0);
+  }
+
+  /// Runs the reactor until all operations completed and no posted work is
+  /// left, or until it was stopped.
+  void run() {
+    while (!stopped_.load(std::memory_order_acquire) &&
+           (pending_ || !work_.empty())) {
+      run_once();
+    }
+    stopped_.store(false, std::memory_order_release);
+  }
+
+  /// Makes a concurrent or the next call to run return,
+  /// this method is thread safe.
+  void stop() noexcept {
+    stopped_.store(true, std::memory_order_release);
+    poller_.notify();
+  }
+
+  /// Returns the count of operations which didn't complete yet
+  std::size_t pending() const noexcept {
+    return pending_;
+  }
+
+private:
+  std::size_t process(int timeout) {
+    std::size_t handled = 0U;
+    poller_.wait(timeout, [&](void* data, std::uint32_t events) {
+      ++handled;
+      dispatch(*static_cast<descriptor*>(data), events);
+    });
+    handled += work_.process();
+    retired_.clear();
+    return handled;
+  }
+
+  void dispatch(descriptor& current, std::uint32_t events) {
+    // Continuations could release the descriptor while it is dispatched,
+    // the storage stays valid until the batch was processed.
+    std::uint32_t const readable = EPOLLIN | EPOLLRDHUP | EPOLLHUP | EPOLLERR;
+    if ((events & readable) && !current.released && current.read.has_value()) {
+      resume_read(current);
+    }
+    if ((events & readable) && !current.released &&
+        current.read_chain.has_value()) {
+      resume_read_chain(current);
+    }
+    if ((events & readable) && !current.released &&
+        current.accept.has_value()) {
+      resume_accept(current);
+    }
+    if ((events & readable) && !current.released &&
+        current.receive.has_value()) {
+      resume_receive(current);
+    }
+    if ((events & readable) && !current.released &&
+        current.exit.has_value()) {
+      resume_wait(current);
+    }
+    if ((events & readable) && !current.released &&
+        current.splice_in.has_value()) {
+      resume_splice(current, &descriptor::splice_in);
+    }
+    std::uint32_t const writable = EPOLLOUT | EPOLLHUP | EPOLLERR;
+    if ((events & writable) && !current.released &&
+        current.write.has_value()) {
+      resume_write(current);
+    }
+    if ((events & writable) && !current.released &&
+        current.write_chain.has_value()) {
+      resume_write_chain(current);
+    }
+    if ((events & writable) && !current.released &&
+        current.send.has_value()) {
+      resume_send(current);
+    }
+    if ((events & writable) && !current.released &&
+        current.splice_out.has_value()) {
+      resume_splice(current, &descriptor::splice_out);
+    }
+  }
+
+  static bool would_block(int error) noexcept {
+    return (error == EAGAIN) || (error == EWOULDBLOCK);
+  }
+
+  /// Returns the state of the descriptor and registers it on first use
+  descriptor* lookup(int fd, int& error) {
+    auto itr = descriptors_.find(fd);
+    if (itr != descriptors_.end()) {
+      return itr->second.get();
+    }
+
+    std::unique_ptr<descriptor> state(new descriptor(fd));
+    // Registering a descriptor which is ready already reports the
+    // readiness immediately, so no edge is lost after a failed attempt.
+    error = poller_.add(fd, state.get());
+    if (error) {
+      return nullptr;
+    }
+    descriptor* const current = state.get();
+    descriptors_.emplace(fd, std::move(state));
+    return current;
+  }
+
+  template <typename Operation>
+  void cancel(detail::io::pending<Operation>& operation) {
+    --pending_;
+    std::move(operation.take().promise).set_exception(
+        detail::io::make_system_error(ECANCELED));
+  }
+
+  template <typename Operation, typename Promise, typename... Args>
+  void suspend(int fd, detail::io::pending<Operation> descriptor::*slot,
+               Promise&& promise, Args&&... args) {
+    suspend(fd, slot,
+            Operation{std::forward<Promise>(promise),
+                      std::forward<Args>(args)...});
+  }
+  template <typename Operation>
+  void suspend(int fd, detail::io::pending<Operation> descriptor::*slot,
+               Operation operation) {
+    int error = 0;
+    descriptor* const current = lookup(fd, error);
+    if (!current) {
+      std::move(operation.promise)
+          .set_exception(detail::io::make_system_error(error));
+      return;
+    }
+    if (((*current).*slot).has_value()) {
+      // Only one operation of every kind can be pending
+      std::move(operation.promise)
+          .set_exception(detail::io::make_system_error(EALREADY));
+      return;
+    }
+    ((*current).*slot).emplace(std::move(operation));
+    ++pending_;
+  }
+
+  static ssize_t read_some(int fd, void* buffer, std::size_t size) noexcept {
+    ssize_t result;
+    do {
+      result = ::read(fd, buffer, size);
+    } while ((result < 0) && (errno == EINTR));
+    return result;
+  }
+
+  static int accept_some(int fd) noexcept {
+    int result;
+    do {
+      result = ::accept4(fd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+    } while ((result < 0) && (errno == EINTR));
+    return result;
+  }
+
+  /// Writes as much as possible and returns zero when all bytes were
+  /// written, otherwise the `errno` value of the failed write.
+  static int write_all(int fd, void const* buffer, std::size_t size,
+                       std::size_t& written) noexcept {
+    while (written < size) {
+      ssize_t const result =
+          ::write(fd, static_cast<char const*>(buffer) + written,
+                  size - written);
+      if (result < 0) {
+        if (errno == EINTR) {
+          continue;
+        }
+        return errno;
+      }
+      written += static_cast<std::size_t>(result);
+    }
+    return 0;
+  }
+
+  /// Writes as many segments as possible and returns zero when the chain
+  /// was written, otherwise the `errno` value of the failed write.
+  static int write_chain_all(int fd, buffer_chain& chain,
+                             std::size_t& written) noexcept {
+    iovec vectors[gather_size];
+    while (!chain.empty()) {
+      std::size_t const count = chain.gather(vectors, gather_size);
+      ssize_t const result = ::writev(fd, vectors, static_cast<int>(count));
+      if (result < 0) {
+        if (errno == EINTR) {
+          continue;
+        }
+        return errno;
+      }
+      chain.consume(static_cast<std::size_t>(result));
+      written += static_cast<std::size_t>(result);
+    }
+    return 0;
+  }
+
+  /// Reads into a new segment of the given size and appends the bytes
+  /// which were read to the chain.
+  static ssize_t read_chain_some(int fd, std::size_t size,
+                                 buffer_chain& chain) {
+    char* data;
+    detail::buffer::segment_ref owner = buffer_chain::allocate(size, data);
+    ssize_t const result = read_some(fd, data, size);
+    if (result > 0) {
+      chain.push_back(std::move(owner), data,
+                      static_cast<std::size_t>(result));
+    }
+    return result;
+  }
+
+  static int receive_some(int fd, datagram_batch& batch) noexcept {
+    mmsghdr* const headers = batch.prepare_receive();
+    int result;
+    do {
+      result = ::recvmmsg(fd, headers, static_cast<unsigned>(batch.capacity()),
+                          MSG_DONTWAIT, nullptr);
+    } while ((result < 0) && (errno == EINTR));
+    if (result > 0) {
+      batch.size_ = static_cast<std::size_t>(result);
+    }
+    return result;
+  }
+
+  /// Sends as many datagrams as possible and returns zero when all
+  /// datagrams were sent, otherwise the `errno` value of the failed send.
+  static int send_all(int fd, datagram_batch& batch,
+                      std::size_t& sent) noexcept {
+    while (sent < batch.size()) {
+      int const result =
+          ::sendmmsg(fd, batch.headers_.data() + sent,
+                     static_cast<unsigned>(batch.size() - sent), MSG_DONTWAIT);
+      if (result < 0) {
+        if (errno == EINTR) {
+          continue;
+        }
+        return errno;
+      }
+      sent += static_cast<std::size_t>(result);
+    }
+    return 0;
+  }
+
+  /// Transfers as many bytes as possible, returns zero when the transfer
+  /// finished, or the `errno` value on failure where the descriptor which
+  /// blocks the transfer is stored for `EAGAIN`.
+  static int transfer(splice_state& state, int& blocker) noexcept {
+    bool retried = false;
+    for (;;) {
+      ssize_t const result =
+          state.tee ? ::tee(state.from, state.to, state.size,
+                            SPLICE_F_NONBLOCK)
+                    : ::splice(state.from, nullptr, state.to, nullptr,
+                               state.size, SPLICE_F_MOVE | SPLICE_F_NONBLOCK);
+      if (result > 0) {
+        state.transferred += static_cast<std::size_t>(result);
+        if (state.tee) {
+          return 0;
+        }
+        retried = false;
+        continue;
+      }
+      if (result == 0) {
+        // The source reached its end
+        return 0;
+      }
+      if (errno == EINTR) {
+        continue;
+      }
+      if (!would_block(errno)) {
+        return errno;
+      }
+
+      // The transfer blocks on the source when it is empty,
+      // otherwise on the destination, unless the bytes arrived after
+      // the attempt, which is ruled out through a second attempt.
+      int available = 0;
+      if ((::ioctl(state.from, FIONREAD, &available) == 0) && !available) {
+        blocker = state.from;
+        return EAGAIN;
+      }
+      if (retried) {
+        blocker = state.to;
+        return EAGAIN;
+      }
+      retried = true;
+    }
+  }
+
+  template <typename Promise>
+  void start_read(int fd, void* buffer, std::size_t size, Promise&& promise) {
+    ssize_t const result = read_some(fd, buffer, size);
+    if (result >= 0) {
+      std::forward<Promise>(promise).set_value(
+          static_cast<std::size_t>(result));
+    } else if (would_block(errno)) {
+      suspend(fd, &descriptor::read, std::forward<Promise>(promise), buffer,
+              size);
+    } else {
+      std::forward<Promise>(promise).set_exception(
+          detail::io::make_system_error(errno));
+    }
+  }
+
+  void resume_read(descriptor& current) {
+    ssize_t const result =
+        read_some(current.fd, current.read->buffer, current.read->size);
+    if ((result < 0) && would_block(errno)) {
+      return;
+    }
+
+    int const error = errno;
+    --pending_;
+    read_operation operation = current.read.take();
+    if (result >= 0) {
+      std::move(operation.promise)
+          .set_value(static_cast<std::size_t>(result));
+    } else {
+      std::move(operation.promise)
+          .set_exception(detail::io::make_system_error(error));
+    }
+  }
+
+  template <typename Promise>
+  void start_accept(int fd, Promise&& promise) {
+    int const result = accept_some(fd);
+    if (result >= 0) {
+      std::forward<Promise>(promise).set_value(result);
+    } else if (would_block(errno)) {
+      suspend(fd, &descriptor::accept, std::forward<Promise>(promise));
+    } else {
+      std::forward<Promise>(promise).set_exception(
+          detail::io::make_system_error(errno));
+    }
+  }
+
+  void resume_accept(descriptor& current) {
+    int const result = accept_some(current.fd);
+    if ((result < 0) && would_block(errno)) {
+      return;
+    }
+
+    int const error = errno;
+    --pending_;
+    accept_operation operation = current.accept.take();
+    if (result >= 0) {
+      std::move(operation.promise).set_value(result);
+    } else {
+      std::move(operation.promise)
+          .set_exception(detail::io::make_system_error(error));
+    }
+  }
+
+  template <typename Promise>
+  void start_write(int fd, void const* buffer, std::size_t size,
+                   Promise&& promise) {
+    std::size_t written = 0U;
+    int const error = write_all(fd, buffer, size, written);
+    if (!error) {
+      std::forward<Promise>(promise).set_value(written);
+    } else if (would_block(error)) {
+      suspend(fd, &descriptor::write, std::forward<Promise>(promise), buffer,
+              size, written);
+    } else {
+      std::forward<Promise>(promise).set_exception(
+          detail::io::make_system_error(error));
+    }
+  }
+
+  void resume_write(descriptor& current) {
+    int const error = write_all(current.fd, current.write->buffer,
+                                current.write->size, current.write->written);
+    if (would_block(error)) {
+      return;
+    }
+
+    --pending_;
+    write_operation operation = current.write.take();
+    if (!error) {
+      std::move(operation.promise).set_value(operation.written);
+    } else {
+      std::move(operation.promise)
+          .set_exception(detail::io::make_system_error(error));
+    }
+  }
+
+  template <typename Promise>
+  void start_write_chain(int fd, buffer_chain chain, Promise&& promise) {
+    std::size_t written = 0U;
+    int const error = write_chain_all(fd, chain, written);
+    if (!error) {
+      std::forward<Promise>(promise).set_value(written);
+    } else if (would_block(error)) {
+      suspend(fd, &descriptor::write_chain, std::forward<Promise>(promise),
+              std::move(chain), written);
+    } else {
+      std::forward<Promise>(promise).set_exception(
+          detail::io::make_system_error(error));
+    }
+  }
+
+  void resume_write_chain(descriptor& current) {
+    int const error = write_chain_all(current.fd, current.write_chain->chain,
+                                      current.write_chain->written);
+    if (would_block(error)) {
+      return;
+    }
+
+    --pending_;
+    write_chain_operation operation = current.write_chain.take();
+    if (!error) {
+      std::move(operation.promise).set_value(operation.written);
+    } else {
+      std::move(operation.promise)
+          .set_exception(detail::io::make_system_error(error));
+    }
+  }
+
+  template <typename Promise>
+  void start_read_chain(int fd, std::size_t size, Promise&& promise) {
+    buffer_chain chain;
+    ssize_t const result = read_chain_some(fd, size, chain);
+    if (result >= 0) {
+      std::forward<Promise>(promise).set_value(std::move(chain));
+    } else if (would_block(errno)) {
+      suspend(fd, &descriptor::read_chain, std::forward<Promise>(promise),
+              size);
+    } else {
+      std::forward<Promise>(promise).set_exception(
+          detail::io::make_system_error(errno));
+    }
+  }
+
+  void resume_read_chain(descriptor& current) {
+    buffer_chain chain;
+    ssize_t const result =
+        read_chain_some(current.fd, current.read_chain->size, chain);
+    if ((result < 0) && would_block(errno)) {
+      return;
+    }
+
+    int const error = errno;
+    --pending_;
+    read_chain_operation operation = current.read_chain.take();
+    if (result >= 0) {
+      std::move(operation.promise).set_value(std::move(chain));
+    } else {
+      std::move(operation.promise)
+          .set_exception(detail::io::make_system_error(error));
+    }
+  }
+
+  template <typename Promise>
+  void start_receive(int fd, datagram_batch& batch, Promise&& promise) {
+    int const result = receive_some(fd, batch);
+    if (result >= 0) {
+      std::forward<Promise>(promise).set_value(
+          static_cast<std::size_t>(result));
+    } else if (would_block(errno)) {
+      suspend(fd, &descriptor::receive, std::forward<Promise>(promise),
+              &batch);
+    } else {
+      std::forward<Promise>(promise).set_exception(
+          detail::io::make_system_error(errno));
+    }
+  }
+
+  void resume_receive(descriptor& current) {
+    int const result = receive_some(current.fd, *current.receive->batch);
+    if ((result < 0) && would_block(errno)) {
+      return;
+    }
+
+    int const error = errno;
+    --pending_;
+    receive_operation operation = current.receive.take();
+    if (result >= 0) {
+      std::move(operation.promise)
+          .set_value(static_cast<std::size_t>(result));
+    } else {
+      std::move(operation.promise)
+          .set_exception(detail::io::make_system_error(error));
+    }
+  }
+
+  template <typename Promise>
+  void start_send(int fd, datagram_batch& batch, Promise&& promise) {
+    std::size_t sent = 0U;
+    int const error = send_all(fd, batch, sent);
+    if (!error) {
+      std::forward<Promise>(promise).set_value(sent);
+    } else if (would_block(error)) {
+      suspend(fd, &descriptor::send, std::forward<Promise>(promise), &batch,
+              sent);
+    } else {
+      std::forward<Promise>(promise).set_exception(
+          detail::io::make_system_error(error));
+    }
+  }
+
+  template <typename Promise>
+  void start_wait(pid_t pid, Promise&& promise) {
+    int status = 0;
+    int error = 0;
+    if (detail::process::try_reap(pid, status, error)) {
+      std::forward<Promise>(promise).set_value(status);
+      return;
+    }
+
+    // A process which exits after it was reaped unsuccessfully makes its
+    // descriptor readable, which is reported when it is registered.
+    detail::io::file_descriptor pidfd;
+    if (!error) {
+      pidfd = detail::process::open_pidfd(pid, error);
+    }
+    if (error) {
+      std::forward<Promise>(promise).set_exception(
+          detail::io::make_system_error(error));
+      return;
+    }
+
+    int const fd = pidfd.get();
+    suspend(fd, &descriptor::exit, std::forward<Promise>(promise), pid,
+            std::move(pidfd));
+  }
+
+  void resume_wait(descriptor& current) {
+    int status = 0;
+    int error = 0;
+    if (!detail::process::try_reap(current.exit->pid, status, error) &&
+        !error) {
+      return;
+    }
+
+    --pending_;
+    exit_operation operation = current.exit.take();
+    // The process descriptor is closed together with the operation
+    release(current.fd);
+    if (!error) {
+      std::move(operation.promise).set_value(status);
+    } else {
+      std::move(operation.promise)
+          .set_exception(detail::io::make_system_error(error));
+    }
+  }
+
+  template <typename Promise>
+  void start_splice(splice_state state, Promise&& promise) {
+    int blocker = -1;
+    int const error = transfer(state, blocker);
+    if (!error) {
+      std::forward<Promise>(promise).set_value(state.transferred);
+    } else if (would_block(error)) {
+      suspend(blocker,
+              (blocker == state.from) ? &descriptor::splice_in
+                                      : &descriptor::splice_out,
+              std::forward<Promise>(promise), state);
+    } else {
+      std::forward<Promise>(promise).set_exception(
+          detail::io::make_system_error(error));
+    }
+  }
+
+  void resume_splice(descriptor& current,
+                     detail::io::pending<splice_operation> descriptor::*slot) {
+    int blocker = -1;
+    int const error = transfer(((current).*slot)->state, blocker);
+    auto const target = (blocker == ((current).*slot)->state.from)
+                            ? &descriptor::splice_in
+                            : &descriptor::splice_out;
+    if (would_block(error) && (blocker == current.fd) && (target == slot)) {
+      return;
+    }
+
+    --pending_;
+    splice_operation operation = ((current).*slot).take();
+    if (would_block(error)) {
+      // The transfer blocks on the other descriptor now
+      suspend(blocker, target, std::move(operation));
+    } else if (!error) {
+      std::move(operation.promise).set_value(operation.state.transferred);
+    } else {
+      std::move(operation.promise)
+          .set_exception(detail::io::make_system_error(error));
+    }
+  }
+
+  void resume_send(descriptor& current) {
+    int const error =
+        send_all(current.fd, *current.send->batch, current.send->sent);
+    if (would_block(error)) {
+      return;
+    }
+
+    --pending_;
+    send_operation operation = current.send.take();
+    if (!error) {
+      std::move(operation.promise).set_value(operation.sent);
+    } else {
+      std::move(operation.promise)
+          .set_exception(detail::io::make_system_error(error));
+    }
+  }
+};
+} // namespace io
+} // namespace cti
+
+#endif // CONTINUABLE_HAS_EPOLL
+#endif // CONTINUABLE_REACTOR_HPP_INCLUDED__
@@ -0,0 +1,229 @@
+
+/*
+
+                        /~` _  _ _|_. _     _ |_ | _
+                        \_,(_)| | | || ||_|(_||_)|(/_
+
+                    https://github.com/Naios/continuable
+                                   v2.0.0
+
+  Copyright(c) 2015 - 2018 Denis Blank <denis.blank at outlook dot com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files(the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions :
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+**/
+
+#ifndef CONTINUABLE_TIMER_HPP_INCLUDED__
+#define CONTINUABLE_TIMER_HPP_INCLUDED__
+
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <thread>
+#include <utility>
+
+#include <continuable/continuable-base.hpp>
+#include <continuable/continuable-promise-base.hpp>
+#include <continuable/continuable-types.hpp>
+#include <continuable/detail/hints.hpp>
+#include <continuable/detail/io.hpp>
+#include <continuable/detail/timer.hpp>
+#include <continuable/detail/types.hpp>
+
+namespace cti {
+/// A hashed hierarchical timer wheel which returns continuables
+/// that are resolved when the timer expired:
+/// ```cpp
+/// cti::timer_wheel timers;
+///
+/// timers.after(std::chrono::seconds(30))
+///   .then([] {
+///     // The connection is idle for 30 seconds
+///   });
+///
+/// timers.run();
+/// ```
+///
+/// Inserting and cancelling a timer is O(1), and all timers of a tick
+/// expire in one batch, which makes the wheel suitable for a huge count
+/// of timers that are cancelled mostly, like per connection timeouts.
+/// Timers are scheduled when the continuable is invoked and expire
+/// on the first tick which isn't earlier than the requested time point,
+/// where the length of a tick is the resolution of the wheel.
+///
+/// Timers which were started with a handle are cancelable through cancel(),
+/// cancelled timers are resolved with a `std::system_error`
+/// of `ECANCELED` (or the error code when the hybrid error type is used).
+///
+/// \attention The wheel isn't thread safe, it must be driven by a single
+///            thread which also invokes the continuables.
+///
+/// \since version 2.0.0
+class timer_wheel {
+  /// The promise which is stored per timer, callbacks are stored
+  /// inline up to the given capacity.
+  using promise_t = promise_base<
+      detail::unique_function_adjustable<
+          64U, void()&&,
+          void(detail::types::dispatch_error_tag,
+               detail::types::error_type)&&>,
+      detail::hints::signature_hint_tag<>>;
+
+public:
+  /// The clock which is used by the wheel
+  using clock = std::chrono::steady_clock;
+  /// The time point of the clock
+  using time_point = clock::time_point;
+  /// The duration of the clock
+  using duration = clock::duration;
+  /// Refers to a timer which was started, usable for cancellation
+  using timer = detail::timer::handle;
+
+private:
+  detail::timer::wheel<promise_t> wheel_;
+  time_point origin_;
+  duration resolution_;
+
+  template <typename Rep, typename Period>
+  auto after(std::chrono::duration<Rep, Period> delay, timer* handle) {
+    return make_continuable<void>([this, delay, handle](auto&& promise) {
+      this->start(clock::now() +
+                      std::chrono::duration_cast<duration>(delay),
+                  handle, std::forward<decltype(promise)>(promise));
+    });
+  }
+
+  auto at(time_point deadline, timer* handle) {
+    return make_continuable<void>([this, deadline, handle](auto&& promise) {
+      this->start(deadline, handle, std::forward<decltype(promise)>(promise));
+    });
+  }
+
+public:
+  /// Creates a timer wheel which ticks with the given resolution
+  explicit timer_wheel(duration resolution = std::chrono::milliseconds(1))
+      : origin_(clock::now()), resolution_(resolution) {
+  }
+
+  /// Returns a continuable which resolves after the given duration,
+  /// counted from the invocation of the continuable.
+  template <typename Rep, typename Period>
+  auto after(std::chrono::duration<Rep, Period> delay) {
+    return after(delay, nullptr);
+  }
+  /// Returns a continuable which resolves after the given duration,
+  /// and stores the handle of the timer when it is started.
+  template <typename Rep, typename Period>
+  auto after(std::chrono::duration<Rep, Period> delay, timer& handle) {
+    return after(delay, &handle);
+  }
+
+  /// Returns a continuable which resolves at the given time point
+  auto at(time_point deadline) {
+    return at(deadline, nullptr);
+  }
+  /// Returns a continuable which resolves at the given time point,
+  /// and stores the handle of the timer when it is started.
+  auto at(time_point deadline, timer& handle) {
+    return at(deadline, &handle);
+  }
+
+  /// Cancels the timer which is referred by the handle,
+  /// returns false when the timer expired or was cancelled already.
+  bool cancel(timer const& handle) {
+    return wheel_.cancel(handle, [](promise_t&& promise) {
+      std::move(promise).set_exception(
+          detail::io::make_system_error(ECANCELED));
+    });
+  }
+
+  /// Advances the wheel to the current time and resolves all timers
+  /// which expired, returns the count of expired timers.
+  std::size_t poll() {
+    return advance(clock::now());
+  }
+
+  /// Advances the wheel to the given time point and resolves all timers
+  /// which expired up to it, returns the count of expired timers.
+  std::size_t advance(time_point now) {
+    // Only ticks which elapsed completely are expired
+    std::uint64_t const elapsed =
+        (now <= origin_) ? 0U
+                         : static_cast<std::uint64_t>((now - origin_) /
+                                                      resolution_);
+    return wheel_.advance(elapsed, [](promise_t&& promise) {
+      std::move(promise).set_value();
+    });
+  }
+
+  /// Returns the time point at which the next timers could expire,
+  /// which is usable as timeout for a blocking wait.
+  time_point next_expiry() const noexcept {
+    std::uint64_t const tick = wheel_.next_tick();
+    if (tick == std::numeric_limits<std::uint64_t>::max()) {
+      return time_point::max();
+    }
+    return origin_ + resolution_ * static_cast<duration::rep>(tick);
+  }
+
+  /// Blocks until the next timers expired,
+  /// returns the count of expired timers.
+  std::size_t run_once() {
+    if (!wheel_.size()) {
+      return 0U;
+    }
+    std::this_thread::sleep_until(next_expiry());
+    return poll();
+  }
+
+  /// Runs the wheel until all timers expired, including the ones
+  /// which are started by the continuations of expired timers.
+  void run() {
+    while (wheel_.size()) {
+      run_once();
+    }
+  }
+
+  /// Returns the count of timers which didn't expire yet
+  std::size_t pending() const noexcept {
+    return wheel_.size();
+  }
+
+private:
+  void start(time_point deadline, timer* handle, promise_t promise) {
+    timer const started = wheel_.insert(tick_of(deadline), std::move(promise));
+    if (handle) {
+      *handle = started;
+    }
+  }
+
+  /// Returns the first tick which doesn't start before the time point
+  std::uint64_t tick_of(time_point point) const noexcept {
+    if (point <= origin_) {
+      return 0U;
+    }
+    duration const elapsed = point - origin_;
+    return static_cast<std::uint64_t>((elapsed + resolution_ - duration(1)) /
+                                      resolution_);
+  }
+};
+} // namespace cti
+
+#endif // CONTINUABLE_TIMER_HPP_INCLUDED__
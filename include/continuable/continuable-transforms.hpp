@@ -68,6 +68,35 @@ inline auto futurize() {
   };
 }
 
+/// Returns a transform that if applied to a continuable,
+/// it will start the continuation chain and blocks the current thread
+/// until the asynchronous result is available.
+///
+/// In contrast to futurize() no shared state is allocated, the result is
+/// resolved into a slot on the stack of the waiting thread, which spins
+/// for a short time and is parked afterwards (through a futex on Linux).
+///
+/// \returns Returns an expected object which holds either the result
+///          or the error the continuation was resolved with:
+/// |          Continuation type        |        Value of the expected       |
+/// | : ------------------------------- | : -------------------------------- |
+/// | `continuable_base with <>`        | a void tag                         |
+/// | `continuable_base with <Arg>`     | `Arg`                              |
+/// | `continuable_base with <Args...>` | `std::tuple<Args...>`              |
+///          The expected provides `is_value()`, `get_value()`,
+///          `is_exception()` and `get_exception()`.
+///
+/// \attention The continuable must be resolved from another thread
+///            or synchronously, otherwise the current thread blocks forever.
+///
+/// \since version 2.0.0
+inline auto wait() {
+  return [](auto&& continuable) {
+    return detail::transforms::wait(
+        std::forward<decltype(continuable)>(continuable));
+  };
+}
+
 /// Returns a transform that if applied to a continuable, it will ignores all
 /// error which ocured until the point the transform was applied.
 ///
@@ -83,6 +112,22 @@ inline auto flatten() {
   };
 }
 } // namespace transforms
+
+/// Blocks the current thread until the given continuable was resolved
+/// and returns its result as expected object.
+///
+/// This is equivalent to `continuable.apply(cti::transforms::wait())`.
+///
+/// \note A continuation which is dropped without being resolved resolves
+///       the result with a `std::future_errc::broken_promise` error.
+///       A custom error type has to be constructible from a
+///       `std::error_code` for this, the application is trapped otherwise.
+///
+/// \since version 2.0.0
+template <typename Data, typename Annotation>
+auto sync_wait(continuable_base<Data, Annotation>&& continuable) {
+  return detail::transforms::wait(std::move(continuable));
+}
 } // namespace cti
 
 #endif // CONTINUABLE_TRANSFORMS_HPP_INCLUDED__
@@ -0,0 +1,208 @@
+
+/*
+
+                        /~` _  _ _|_. _     _ |_ | _
+                        \_,(_)| | | || ||_|(_||_)|(/_
+
+                    https://github.com/Naios/continuable
+                                   v2.0.0
+
+  Copyright(c) 2015 - 2018 Denis Blank <denis.blank at outlook dot com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files(the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions :
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+**/
+
+#ifndef CONTINUABLE_URING_HPP_INCLUDED__
+#define CONTINUABLE_URING_HPP_INCLUDED__
+
+#include <continuable/detail/features.hpp>
+
+// Exlude this header when io_uring isn't available
+#ifdef CONTINUABLE_HAS_IO_URING
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+
+#include <continuable/continuable-base.hpp>
+#include <continuable/continuable-promise-base.hpp>
+#include <continuable/continuable-types.hpp>
+#include <continuable/detail/hints.hpp>
+#include <continuable/detail/io.hpp>
+#include <continuable/detail/types.hpp>
+#include <continuable/detail/uring.hpp>
+
+namespace cti {
+/// Provides asynchronous I/O facilities which return continuables
+namespace io {
+/// An io_uring instance which performs file I/O asynchronously,
+/// every operation returns a continuable resolving with the count of
+/// transferred bytes:
+/// ```cpp
+/// cti::io::uring ring;
+///
+/// ring.read_at(fd, buffer, sizeof(buffer), 0)
+///   .then([](std::size_t read) {
+///     // ...
+///   });
+///
+/// ring.run();
+/// ```
+///
+/// Operations are queued into the submission queue when the continuable
+/// is invoked and are submitted in batches when the ring is polled or run.
+/// Completions are reaped in bulk, the promises are stored in reused slots
+/// and resolved directly from the completion queue entries,
+/// so there is no allocation per operation.
+///
+/// Failed operations are resolved with a `std::system_error`
+/// (or the error code when the hybrid error type is used).
+///
+/// \attention The ring isn't thread safe, it must be driven by a single
+///            thread which also invokes the continuables.
+///            The buffers must stay valid until the operation completed.
+///
+/// \since version 2.0.0
+class uring {
+  /// The promise which is stored per operation, callbacks are stored
+  /// inline up to the given capacity.
+  using promise_t = promise_base<
+      detail::unique_function_adjustable<
+          64U, void(std::size_t)&&,
+          void(detail::types::dispatch_error_tag,
+               detail::types::error_type)&&>,
+      detail::hints::signature_hint_tag<std::size_t>>;
+
+  detail::uring::ring ring_;
+  detail::uring::operation_pool<promise_t> operations_;
+
+public:
+  /// The default count of submission queue entries
+  static constexpr unsigned default_entries = 256U;
+
+  /// Sets up the io_uring instance with the given count of submission
+  /// queue entries, throws a `std::system_error` on failure.
+  explicit uring(unsigned entries = default_entries) : ring_(entries) {
+  }
+
+  /// Reads up to `size` bytes at the given offset of the file into
+  /// the buffer, resolves with the count of bytes read.
+  auto read_at(int fd, void* buffer, std::size_t size, std::uint64_t offset) {
+    return make_continuable<std::size_t>(
+        [this, fd, buffer, size, offset](auto&& promise) {
+          this->prepare(IORING_OP_READ, fd, buffer, size, offset,
+                        std::forward<decltype(promise)>(promise));
+        });
+  }
+
+  /// Writes up to `size` bytes of the buffer at the given offset of
+  /// the file, resolves with the count of bytes written.
+  auto write_at(int fd, void const* buffer, std::size_t size,
+                std::uint64_t offset) {
+    return make_continuable<std::size_t>(
+        [this, fd, buffer, size, offset](auto&& promise) {
+          this->prepare(IORING_OP_WRITE, fd, buffer, size, offset,
+                        std::forward<decltype(promise)>(promise));
+        });
+  }
+
+  /// Flushes the file to the storage, resolves with zero
+  auto fsync(int fd) {
+    return make_continuable<std::size_t>([this, fd](auto&& promise) {
+      this->prepare(IORING_OP_FSYNC, fd, nullptr, 0U, 0U,
+                    std::forward<decltype(promise)>(promise));
+    });
+  }
+
+  /// Submits the queued operations and resolves all operations which
+  /// completed already without blocking, returns the count of
+  /// resolved operations.
+  std::size_t poll() {
+    ring_.submit();
+    return reap();
+  }
+
+  /// Submits the queued operations and blocks until at least one operation
+  /// completed, returns the count of resolved operations.
+  ///
+  /// Throws a `std::system_error` when the ring failed to wait and no
+  /// operation completed, the operations stay in flight then, since the
+  /// kernel may still access their buffers.
+  std::size_t run_once() {
+    if (!operations_.in_flight()) {
+      return 0U;
+    }
+    int const result = ring_.wait();
+    std::size_t const reaped = reap();
+    if ((result < 0) && !reaped) {
+      detail::io::throw_system_error(-result, "io_uring_enter");
+    }
+    return reaped;
+  }
+
+  /// Runs the ring until all operations completed, including the ones
+  /// which are started by the continuations of completed operations.
+  void run() {
+    while (operations_.in_flight()) {
+      run_once();
+    }
+  }
+
+  /// Returns the count of operations which didn't complete yet
+  std::size_t pending() const noexcept {
+    return operations_.in_flight();
+  }
+
+private:
+  void prepare(std::uint8_t opcode, int fd, void const* buffer,
+               std::size_t size, std::uint64_t offset, promise_t promise) {
+    io_uring_sqe* const sqe = ring_.acquire();
+    if (!sqe) {
+      std::move(promise).set_exception(detail::io::make_system_error(EBUSY));
+      return;
+    }
+
+    // A single operation transfers at most 2 GiB like read and write do
+    std::size_t const limit = 0x7FFFF000U;
+    sqe->opcode = opcode;
+    sqe->fd = fd;
+    sqe->addr = reinterpret_cast<std::uint64_t>(buffer);
+    sqe->len = static_cast<std::uint32_t>(size < limit ? size : limit);
+    sqe->off = offset;
+    sqe->user_data = operations_.acquire(std::move(promise));
+    ring_.push();
+  }
+
+  std::size_t reap() {
+    return ring_.reap([this](std::uint64_t user_data, std::int32_t result) {
+      promise_t promise = operations_.release(user_data);
+      if (result < 0) {
+        std::move(promise).set_exception(
+            detail::io::make_system_error(-result));
+      } else {
+        std::move(promise).set_value(static_cast<std::size_t>(result));
+      }
+    });
+  }
+};
+} // namespace io
+} // namespace cti
+
+#endif // CONTINUABLE_HAS_IO_URING
+#endif // CONTINUABLE_URING_HPP_INCLUDED__
@@ -0,0 +1,326 @@
+
+/*
+
+                        /~` _  _ _|_. _     _ |_ | _
+                        \_,(_)| | | || ||_|(_||_)|(/_
+
+                    https://github.com/Naios/continuable
+                                   v2.0.0
+
+  Copyright(c) 2015 - 2018 Denis Blank <denis.blank at outlook dot com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files(the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions :
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+**/
+
+#ifndef CONTINUABLE_WATCHER_HPP_INCLUDED__
+#define CONTINUABLE_WATCHER_HPP_INCLUDED__
+
+#include <continuable/detail/features.hpp>
+
+// Exlude this header when epoll isn't available
+#ifdef CONTINUABLE_HAS_EPOLL
+
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <sys/inotify.h>
+
+#include <continuable/continuable-base.hpp>
+#include <continuable/continuable-promise-base.hpp>
+#include <continuable/continuable-reactor.hpp>
+#include <continuable/detail/hints.hpp>
+#include <continuable/detail/io.hpp>
+#include <continuable/detail/types.hpp>
+#include <continuable/detail/watcher.hpp>
+
+namespace cti {
+/// Provides asynchronous I/O facilities which return continuables
+namespace io {
+/// Describes the changes of a single path during a window of the watcher
+///
+/// \since version 2.0.0
+struct file_change {
+  /// The path which changed, which is empty when the kernel dropped
+  /// events, the watched paths need to be rescanned in that case.
+  std::string path;
+  /// The inotify events (`IN_*`) which occurred on the path
+  std::uint32_t events;
+};
+
+/// Watches files and directories through inotify and delivers their
+/// changes as a stream of continuations:
+/// ```cpp
+/// cti::io::file_watcher watcher(reactor, std::chrono::milliseconds(100));
+/// watcher.watch("config");
+///
+/// std::function<void()> reload = [&] {
+///   watcher.next().then([&](std::vector<cti::io::file_change> changes) {
+///     for (cti::io::file_change const& change : changes) {
+///       // ...
+///     }
+///     reload();
+///   });
+/// };
+/// ```
+///
+/// The first event opens a window of the configured duration, all events
+/// which arrive within the window are coalesced per path, so a burst of
+/// writes to a file is delivered as a single change. The window isn't
+/// extended by later events, which bounds the latency of a change.
+///
+/// The events are read through the reactor only while a continuation
+/// waits for changes or a window is open, changes which occur in between
+/// are queued by the kernel and delivered on the next call to next().
+///
+/// \attention The watcher must outlive the continuables it returned,
+///            and only one continuation can wait for changes at a time.
+///
+/// \since version 2.0.0
+class file_watcher {
+  using changes_t = std::vector<file_change>;
+  using promise_t = promise_base<
+      detail::unique_function_adjustable<
+          64U, void(changes_t)&&,
+          void(detail::types::dispatch_error_tag,
+               detail::types::error_type)&&>,
+      detail::hints::signature_hint_tag<changes_t>>;
+
+  reactor& reactor_;
+  std::chrono::nanoseconds window_;
+  detail::io::file_descriptor inotify_;
+  detail::io::file_descriptor timer_;
+  std::unique_ptr<char[]> buffer_;
+  std::uint64_t expirations_ = 0U;
+  /// The watched paths by their watch descriptor
+  std::unordered_map<int, std::string> watches_;
+  /// The changes of the current window in the order of their occurrence
+  changes_t changes_;
+  std::unordered_map<std::string, std::size_t> indices_;
+  detail::io::pending<promise_t> waiting_;
+  bool reading_ = false;
+  /// Is true while the window is open
+  bool timing_ = false;
+  /// Is true when the window closed while no continuation was waiting
+  bool expired_ = false;
+  bool closing_ = false;
+
+public:
+  /// The events which are watched by default
+  static constexpr std::uint32_t default_events =
+      IN_ATTRIB | IN_CLOSE_WRITE | IN_CREATE | IN_DELETE | IN_DELETE_SELF |
+      IN_MODIFY | IN_MOVE_SELF | IN_MOVED_FROM | IN_MOVED_TO;
+
+  /// Creates a watcher which reads its events through the given reactor
+  /// and coalesces the events within the given window,
+  /// throws a `std::system_error` on failure.
+  explicit file_watcher(
+      reactor& loop,
+      std::chrono::nanoseconds window = std::chrono::milliseconds(50))
+      : reactor_(loop), window_(window),
+        inotify_(detail::watcher::open_inotify()),
+        timer_(detail::watcher::open_timer()),
+        buffer_(new char[detail::watcher::buffer_size]) {
+  }
+  /// Resolves a waiting continuation with `ECANCELED`
+  ~file_watcher() {
+    closing_ = true;
+    reactor_.release(inotify_.get());
+    reactor_.release(timer_.get());
+    if (waiting_.has_value()) {
+      waiting_.take().set_exception(
+          detail::io::make_system_error(ECANCELED));
+    }
+  }
+
+  file_watcher(file_watcher const&) = delete;
+  file_watcher(file_watcher&&) = delete;
+  file_watcher& operator=(file_watcher const&) = delete;
+  file_watcher& operator=(file_watcher&&) = delete;
+
+  /// Watches the file or the direct children of the directory at the
+  /// given path, returns the watch descriptor which identifies the watch,
+  /// throws a `std::system_error` on failure.
+  int watch(std::string const& path,
+            std::uint32_t events = default_events) {
+    int const wd = ::inotify_add_watch(inotify_.get(), path.c_str(), events);
+    if (wd < 0) {
+      detail::io::throw_system_error(errno, "inotify_add_watch");
+    }
+    watches_[wd] = path;
+    return wd;
+  }
+
+  /// Stops watching the given watch descriptor, the removal is delivered
+  /// as change with the `IN_IGNORED` event.
+  void unwatch(int wd) noexcept {
+    ::inotify_rm_watch(inotify_.get(), wd);
+  }
+
+  /// Returns a continuable which resolves with the changes of the next
+  /// window, in the order in which the paths changed first.
+  auto next() {
+    return make_continuable<changes_t>([this](auto&& promise) {
+      this->start_next(std::forward<decltype(promise)>(promise));
+    });
+  }
+
+private:
+  template <typename Promise>
+  void start_next(Promise&& promise) {
+    if (waiting_.has_value()) {
+      std::forward<Promise>(promise).set_exception(
+          detail::io::make_system_error(EALREADY));
+      return;
+    }
+
+    waiting_.emplace(std::forward<Promise>(promise));
+    if (expired_) {
+      deliver();
+    } else {
+      read();
+    }
+  }
+
+  void read() {
+    if (reading_ || closing_) {
+      return;
+    }
+
+    reading_ = true;
+    reactor_
+        .async_read_some(inotify_.get(), buffer_.get(),
+                         detail::watcher::buffer_size)
+        .then([this](std::size_t size) {
+          reading_ = false;
+          collect(size);
+        })
+        .fail([this](detail::types::error_type error) {
+          // The read is cancelled on purpose when no continuation waits
+          if (closing_ || !reading_) {
+            return;
+          }
+          reading_ = false;
+          if (waiting_.has_value()) {
+            waiting_.take().set_exception(std::move(error));
+          }
+        });
+  }
+
+  /// Stops reading when no continuation waits and the window is closed,
+  /// so the reactor isn't kept busy by the watcher.
+  void pause() {
+    if (reading_ && !waiting_.has_value() && !timing_) {
+      reading_ = false;
+      reactor_.release(inotify_.get());
+    }
+  }
+
+  void collect(std::size_t size) {
+    detail::watcher::for_each_event(
+        buffer_.get(), size,
+        [&](int wd, std::uint32_t mask, char const* name, std::size_t length) {
+          if (mask & IN_Q_OVERFLOW) {
+            coalesce(std::string(), mask);
+            return;
+          }
+          auto const itr = watches_.find(wd);
+          if (itr == watches_.end()) {
+            return;
+          }
+
+          std::string path = itr->second;
+          if (length) {
+            path.append(1U, '/').append(name, length);
+          }
+          if (mask & IN_IGNORED) {
+            watches_.erase(itr);
+          }
+          coalesce(std::move(path), mask);
+        });
+
+    if (!changes_.empty() && !timing_ && !expired_) {
+      open_window();
+    }
+    if (waiting_.has_value() || timing_) {
+      read();
+    }
+  }
+
+  void coalesce(std::string path, std::uint32_t mask) {
+    auto const itr = indices_.find(path);
+    if (itr != indices_.end()) {
+      changes_[itr->second].events |= mask;
+    } else {
+      indices_.emplace(path, changes_.size());
+      changes_.push_back(file_change{std::move(path), mask});
+    }
+  }
+
+  void open_window() {
+    // A window which can't be timed is closed immediately
+    if (!window_.count() ||
+        detail::watcher::arm(timer_.get(), window_) != 0) {
+      close_window();
+      return;
+    }
+
+    timing_ = true;
+    reactor_
+        .async_read_some(timer_.get(), &expirations_, sizeof(expirations_))
+        .then([this](std::size_t) {
+          timing_ = false;
+          close_window();
+        })
+        .fail([this](detail::types::error_type) {
+          if (!closing_) {
+            timing_ = false;
+            close_window();
+          }
+        });
+  }
+
+  void close_window() {
+    if (waiting_.has_value()) {
+      deliver();
+    } else {
+      expired_ = true;
+    }
+    pause();
+  }
+
+  void deliver() {
+    expired_ = false;
+    changes_t changes = std::move(changes_);
+    changes_.clear();
+    indices_.clear();
+    waiting_.take().set_value(std::move(changes));
+  }
+};
+} // namespace io
+} // namespace cti
+
+#endif // CONTINUABLE_HAS_EPOLL
+#endif // CONTINUABLE_WATCHER_HPP_INCLUDED__
@@ -33,6 +33,8 @@
 
 #include <continuable/continuable-api.hpp>
 #include <continuable/continuable-base.hpp>
+#include <continuable/continuable-coroutine.hpp>
+#include <continuable/continuable-generator.hpp>
 #include <continuable/continuable-promise-base.hpp>
 #include <continuable/continuable-trait.hpp>
 #include <continuable/continuable-transforms.hpp>
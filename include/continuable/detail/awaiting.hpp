@@ -31,14 +31,27 @@
 #ifndef CONTINUABLE_DETAIL_AWAITING_HPP_INCLUDED__
 #define CONTINUABLE_DETAIL_AWAITING_HPP_INCLUDED__
 
+#include <continuable/detail/features.hpp>
+
 // Exlude this header when coroutines are not available
-#ifdef CONTINUABLE_HAS_EXPERIMENTAL_COROUTINE
+#ifdef CONTINUABLE_HAS_COROUTINE
 
+#include <atomic>
 #include <cassert>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <tuple>
+
+#if defined(CONTINUABLE_HAS_EXPERIMENTAL_COROUTINE)
 #include <experimental/coroutine>
+#else // CONTINUABLE_HAS_EXPERIMENTAL_COROUTINE
+#include <coroutine>
+#endif // CONTINUABLE_HAS_EXPERIMENTAL_COROUTINE
 
 #include <continuable/continuable-api.hpp>
 #include <continuable/detail/base.hpp>
+#include <continuable/detail/composition.hpp>
 #include <continuable/detail/expected.hpp>
 #include <continuable/detail/features.hpp>
 #include <continuable/detail/hints.hpp>
@@ -53,11 +66,93 @@ namespace cti {
 namespace detail {
 namespace awaiting {
 /// We import the coroutine handle in our namespace
+#if defined(CONTINUABLE_HAS_EXPERIMENTAL_COROUTINE)
 using std::experimental::coroutine_handle;
+using std::experimental::suspend_always;
+#else  // CONTINUABLE_HAS_EXPERIMENTAL_COROUTINE
+using std::coroutine_handle;
+using std::noop_coroutine;
+using std::suspend_always;
+#endif // CONTINUABLE_HAS_EXPERIMENTAL_COROUTINE
+
+/// Returns the slot of the current thread into which the resumption of an
+/// awaiting coroutine is transferred, while a continuable returning
+/// coroutine completes.
+///
+/// This makes it possible for the completing coroutine to resume
+/// its awaiter through symmetric transfer instead of resuming it
+/// recursively on the current stack.
+inline coroutine_handle<>*& transfer_slot() noexcept {
+  static thread_local coroutine_handle<>* slot = nullptr;
+  return slot;
+}
+
+/// Resumes the given coroutine, or transfers its resumption to the
+/// coroutine which is completing on the current thread.
+inline void resume_or_transfer(coroutine_handle<> handle) {
+  coroutine_handle<>* const slot = transfer_slot();
+  if (slot && !*slot) {
+    *slot = handle;
+  } else {
+    handle.resume();
+  }
+}
+
+/// Invokes the given resolver while the resumption of a coroutine which
+/// awaits the result is transferred into a slot, returns the coroutine
+/// which shall be resumed next or a null handle.
+template <typename Resolver>
+coroutine_handle<> transfer_resumption(Resolver&& resolver) {
+  coroutine_handle<> next;
+  coroutine_handle<>* const previous = transfer_slot();
+  transfer_slot() = &next;
+
+  std::forward<Resolver>(resolver)();
+
+  transfer_slot() = previous;
+  return next;
+}
+
+/// The awaiter of a coroutine which completes its awaiting coroutine
+/// on suspension, the awaiting coroutine is resumed through symmetric
+/// transfer when the completion resumed it synchronously.
+///
+/// \tparam Completion A callable object taking the coroutine handle,
+///         which returns the coroutine to resume next or a null handle.
+template <typename Promise, typename Completion>
+struct transfer_awaiter {
+  bool await_ready() const noexcept {
+    return false;
+  }
+
+#if defined(CONTINUABLE_HAS_EXPERIMENTAL_COROUTINE)
+  void await_suspend(coroutine_handle<Promise> handle) noexcept {
+    coroutine_handle<> next = Completion{}(handle);
+    if (next) {
+      next.resume();
+    }
+  }
+#else  // CONTINUABLE_HAS_EXPERIMENTAL_COROUTINE
+  coroutine_handle<> await_suspend(coroutine_handle<Promise> handle) noexcept {
+    coroutine_handle<> next = Completion{}(handle);
+    if (next) {
+      return next;
+    }
+    return noop_coroutine();
+  }
+#endif // CONTINUABLE_HAS_EXPERIMENTAL_COROUTINE
+
+  void await_resume() noexcept {
+  }
+};
 
 /// An object which provides the internal buffer and helper methods
 /// for waiting on a continuable in a stackless coroutine.
-template <typename Continuable>
+///
+/// \tparam AsExpected Returns the result as expected object from `co_await`
+///         instead of unwrapping it, so errors are returned as value rather
+///         than being thrown.
+template <typename Continuable, bool AsExpected = false>
 class awaitable {
   using trait_t = util::expected_result_trait_t<Continuable>;
 
@@ -66,11 +161,21 @@ class awaitable {
   /// A cache which is used to pass the result of the continuation
   /// to the coroutine.
   typename trait_t::expected_type result_;
+  /// Is set by the first party out of the callback and await_suspend
+  /// which completes, the second one decides how to continue.
+  std::atomic<bool> completed_{false};
 
 public:
   explicit constexpr awaitable(Continuable&& continuable)
       : continuable_(std::move(continuable)) {
   }
+  /// The awaitable is returned by value from create_awaiter, which requires
+  /// a move constructor before C++17. It is never moved after suspending.
+  awaitable(awaitable&& right)
+      : continuable_(std::move(right.continuable_)),
+        result_(std::move(right.result_)),
+        completed_(right.completed_.load(std::memory_order_relaxed)) {
+  }
 
   /// Since continuables are evaluated lazily we are not
   /// capable to say whether the resumption will be instantly.
@@ -79,19 +184,41 @@ public:
   }
 
   /// Suspend the current context
+  ///
+  /// Returns false when the continuable was resolved synchronously,
+  /// which continues the coroutine without a suspend and resume round-trip
+  /// rather than resuming it recursively from inside the callback.
   // TODO Convert this to an r-value function once possible
-  void await_suspend(coroutine_handle<> h) {
+  bool await_suspend(coroutine_handle<> h) {
     // Forward every result to the current awaitable
     std::move(continuable_)
         .next([h, this](auto&&... args) mutable {
           resolve(std::forward<decltype(args)>(args)...);
-          h.resume();
+
+          // Only resume the coroutine when await_suspend returned already,
+          // otherwise the coroutine isn't suspended at all.
+          if (completed_.exchange(true, std::memory_order_acq_rel)) {
+            resume_or_transfer(h);
+          }
         })
         .done();
+
+    return !completed_.exchange(true, std::memory_order_acq_rel);
   }
 
   /// Resume the coroutine represented by the handle
-  auto await_resume() noexcept(false) {
+  auto await_resume() noexcept(AsExpected) {
+    return resume(std::integral_constant<bool, AsExpected>{});
+  }
+
+private:
+  /// Returns the result or the error as expected object
+  auto resume(std::true_type /*AsExpected*/) noexcept {
+    return std::move(result_);
+  }
+
+  /// Returns the unwrapped result or throws the error
+  auto resume(std::false_type /*AsExpected*/) {
     if (result_) {
       // When the result was resolved return it
       return trait_t::unwrap(std::move(result_));
@@ -105,7 +232,6 @@ public:
 #endif // CONTINUABLE_WITH_EXCEPTIONS
   }
 
-private:
   /// Resolve the continuation through the result
   template <typename... Args>
   void resolve(Args&&... args) {
@@ -118,48 +244,426 @@ private:
   }
 };
 
+/// An awaitable object for `all` compositions, which invokes every
+/// continuation of the composition directly and resumes the coroutine once
+/// after the last one completed or after the first one failed.
+///
+/// The results are constructed in place inside a shared state, which
+/// avoids materializing the composition into a std::tuple and the wrapping
+/// of the result through the generic awaitable.
+///
+/// The shared state outlives the coroutine frame, since the coroutine may
+/// be resumed and destroyed on the first error while other continuations
+/// of the composition are still pending.
+template <typename Composition,
+          typename Signature = composition::signature_of_t<Composition>>
+class all_awaitable;
+template <typename Composition, typename... Args>
+class all_awaitable<Composition, traits::identity<Args...>> {
+
+  /// The state which is shared between the awaitable and the callbacks
+  struct state {
+    /// The results which are constructed in place on arrival
+    std::tuple<composition::detail::result_slot<Args>...> result_;
+    /// The count of continuations which didn't complete yet
+    std::atomic<std::size_t> left_{std::tuple_size<Composition>::value};
+    /// The count of parties out of the suspension and the completion
+    /// of the composition which didn't finish yet, the last one
+    /// resumes the coroutine.
+    std::atomic<std::size_t> pending_{2U};
+    /// Is set when the composition completed or failed
+    std::atomic<bool> ready_{false};
+    /// Is set by the first continuation which failed
+    std::atomic<bool> failed_{false};
+    /// The first error which was raised
+    types::error_type error_;
+    /// The coroutine which is resumed on completion
+    coroutine_handle<> handle_;
+
+    /// Returns true when the suspension was the last pending party
+    bool suspended() noexcept {
+      return pending_.fetch_sub(1U, std::memory_order_acq_rel) == 1U;
+    }
+
+    /// Marks the composition as completed and resumes the coroutine
+    /// when it was suspended already.
+    void complete() {
+      if (!ready_.exchange(true, std::memory_order_acq_rel) &&
+          (pending_.fetch_sub(1U, std::memory_order_acq_rel) == 1U)) {
+        resume_or_transfer(handle_);
+      }
+    }
+
+    void complete_one() {
+      if (left_.fetch_sub(1U, std::memory_order_acq_rel) == 1U) {
+        complete();
+      }
+    }
+  };
+
+  /// The continuations which are invoked upon suspension
+  Composition composition_;
+  std::shared_ptr<state> state_;
+
+  template <std::size_t From, std::size_t To>
+  struct partial_callback {
+    std::shared_ptr<state> state_;
+
+    template <typename... PartialArgs>
+    void operator()(PartialArgs&&... args) && {
+      static_assert(sizeof...(args) == (To - From),
+                    "Submission called with the wrong amount of arguments!");
+
+      composition::detail::assign(traits::size_constant<From>{},
+                                  state_->result_,
+                                  std::forward<PartialArgs>(args)...);
+      state_->complete_one();
+    }
+
+    void operator()(types::dispatch_error_tag, types::error_type error) && {
+      // Resume the coroutine on the first error without waiting
+      // for the remaining continuations.
+      if (!state_->failed_.exchange(true, std::memory_order_acq_rel)) {
+        state_->error_ = std::move(error);
+        state_->complete();
+      }
+      state_->complete_one();
+    }
+
+    template <typename... PartialArgs>
+    void set_value(PartialArgs&&... args) {
+      std::move(*this)(std::forward<PartialArgs>(args)...);
+    }
+
+    void set_exception(types::error_type error) {
+      std::move(*this)(types::dispatch_error_tag{}, std::move(error));
+    }
+  };
+
+  void unwrap(traits::identity<>) {
+  }
+  template <typename T>
+  T unwrap(traits::identity<T>) {
+    return std::move(std::get<0>(state_->result_).get());
+  }
+  template <typename First, typename Second, typename... Rest>
+  std::tuple<First, Second, Rest...>
+  unwrap(traits::identity<First, Second, Rest...>) {
+    return traits::unpack(state_->result_, [](auto&... slots) {
+      return std::tuple<First, Second, Rest...>(std::move(slots.get())...);
+    });
+  }
+
+public:
+  explicit all_awaitable(Composition&& composition)
+      : composition_(std::move(composition)),
+        state_(std::make_shared<state>()) {
+  }
+
+  bool await_ready() const noexcept {
+    return false;
+  }
+
+  /// Suspend the current context, returns false when the composition
+  /// completed or failed synchronously.
+  bool await_suspend(coroutine_handle<> h) {
+    state_->handle_ = h;
+
+    composition::invoke_composition(composition_, [this](auto from, auto to) {
+      return partial_callback<decltype(from)::value, decltype(to)::value>{
+          state_};
+    });
+
+    return !state_->suspended();
+  }
+
+  /// Resume the coroutine with the results of the composition
+  auto await_resume() noexcept(false) {
+    if (state_->failed_.load(std::memory_order_acquire)) {
+#if defined(CONTINUABLE_WITH_EXCEPTIONS)
+      std::rethrow_exception(state_->error_);
+#else  // CONTINUABLE_WITH_EXCEPTIONS
+      // Returning error types in await isn't supported as of now
+      util::trap();
+#endif // CONTINUABLE_WITH_EXCEPTIONS
+    }
+    return unwrap(traits::identity<Args...>{});
+  }
+};
+
+/// An awaitable object which resumes the coroutine on the given executor.
+///
+/// The coroutine handle is passed directly as work to the executor,
+/// since it is invocable itself and as small as a pointer.
+template <typename Executor>
+class executor_awaitable {
+  Executor executor_;
+
+public:
+  explicit executor_awaitable(Executor executor)
+      : executor_(std::move(executor)) {
+  }
+
+  bool await_ready() const noexcept {
+    return false;
+  }
+
+  void await_suspend(coroutine_handle<> h) {
+    std::move(executor_)(h);
+  }
+
+  void await_resume() noexcept {
+  }
+};
+
 /// Converts a continuable into an awaitable object as described by
 /// the C++ coroutine TS.
-template <typename T>
-constexpr auto create_awaiter(T&& continuable) {
-  return awaitable<std::decay_t<T>>(std::forward<T>(continuable));
+template <typename Data, typename Annotation>
+auto create_awaiter(continuable_base<Data, Annotation>&& continuable) {
+  auto materialized = base::attorney::materialize(std::move(continuable));
+  return awaitable<decltype(materialized)>(std::move(materialized));
 }
-} // namespace awaiting
-} // namespace detail
-} // namespace cti
+/// Converts an `all` composition into an awaitable object, which
+/// awaits the continuations of the composition directly.
+template <typename Data>
+auto create_awaiter(
+    continuable_base<Data, composition::strategy_all_tag>&& continuable) {
+  return all_awaitable<Data>(
+      base::attorney::consume_data(std::move(continuable)));
+}
+
+/// Converts a continuable into an awaitable object, which returns
+/// the result or the error as expected object.
+template <typename Data, typename Annotation>
+auto create_expected_awaiter(
+    continuable_base<Data, Annotation>&& continuable) {
+  auto materialized = base::attorney::materialize(std::move(continuable));
+  return awaitable<decltype(materialized), true>(std::move(materialized));
+}
+
+/// A per-thread pool which caches the frames of continuable returning
+/// coroutines in size classes, since those are usually short-lived
+/// and created in large numbers.
+///
+/// Frames which are released on another thread than the one which
+/// allocated them are cached on the releasing thread.
+class frame_pool {
+  /// The granularity of the size classes
+  static constexpr std::size_t granularity = 64U;
+  /// The count of size classes, larger frames aren't pooled
+  static constexpr std::size_t classes = 16U;
+  /// The maximum count of frames which is cached per size class
+  static constexpr std::size_t capacity = 64U;
+
+  struct node {
+    node* next;
+  };
+
+  struct cache {
+    node* heads[classes] = {};
+    std::size_t counts[classes] = {};
 
-namespace std {
-namespace experimental {
-template <typename Data, typename... Args, typename... FunctionArgs>
-struct coroutine_traits<
-    cti::continuable_base<Data,
-                          cti::detail::hints::signature_hint_tag<Args...>>,
-    FunctionArgs...> /*{
-  struct promise_type {
-    // boost::promise<R> p;
-    auto get_return_object() {
-      // return p.get_future();
+    cache() = default;
+    ~cache() {
+      for (node* head : heads) {
+        while (head) {
+          node* const next = head->next;
+          ::operator delete(head);
+          head = next;
+        }
+      }
     }
-    suspend_always initial_suspend() {
-      return {};
+  };
+
+  static cache& local() noexcept {
+    static thread_local cache instance;
+    return instance;
+  }
+
+  static constexpr std::size_t class_of(std::size_t size) noexcept {
+    return (size - 1U) / granularity;
+  }
+
+public:
+  /// Allocates a frame of the given size
+  static void* allocate(std::size_t size) {
+    std::size_t const index = class_of(size);
+    if (index >= classes) {
+      return ::operator new(size);
     }
-    suspend_never final_suspend() {
-      return {};
+
+    cache& current = local();
+    if (node* const head = current.heads[index]) {
+      current.heads[index] = head->next;
+      --current.counts[index];
+      return head;
     }
-    void set_exception(std::exception_ptr e) {
-      // p.set_exception(std::move(e));
+    return ::operator new((index + 1U) * granularity);
+  }
+
+  /// Releases a frame of the given size
+  static void deallocate(void* frame, std::size_t size) noexcept {
+    std::size_t const index = class_of(size);
+    if (index >= classes) {
+      ::operator delete(frame);
+      return;
     }
-    void unhandled_exception() {
-      // p.set_exception(std::current_exception());
+
+    cache& current = local();
+    if (current.counts[index] >= capacity) {
+      ::operator delete(frame);
+      return;
     }
-    template <typename U>
-    void return_value(U&& u) {
-      // p.set_value(std::forward<U>(u));
+    current.heads[index] = ::new (frame) node{current.heads[index]};
+    ++current.counts[index];
+  }
+};
+
+/// The allocator which is used for frames of continuable returning
+/// coroutines. A custom allocator providing a static `allocate(std::size_t)`
+/// and `deallocate(void*, std::size_t)` method may be set through
+/// defining `CONTINUABLE_WITH_CUSTOM_FRAME_ALLOCATOR`.
+#ifdef CONTINUABLE_WITH_CUSTOM_FRAME_ALLOCATOR
+using frame_allocator = CONTINUABLE_WITH_CUSTOM_FRAME_ALLOCATOR;
+#else  // CONTINUABLE_WITH_CUSTOM_FRAME_ALLOCATOR
+using frame_allocator = frame_pool;
+#endif // CONTINUABLE_WITH_CUSTOM_FRAME_ALLOCATOR
+
+/// Provides the `co_return` statement of a continuable returning coroutine,
+/// which is `return_void` for continuables without a result and
+/// `return_value` for continuables with a result.
+template <typename Expected>
+class promise_return {
+protected:
+  /// The result of the coroutine
+  Expected result_;
+
+public:
+  template <typename T>
+  void return_value(T&& value) {
+    result_.set_value(std::forward<T>(value));
+  }
+};
+template <>
+class promise_return<util::expected<util::detail::void_guard_tag>> {
+protected:
+  /// The result of the coroutine
+  util::expected<util::detail::void_guard_tag> result_;
+
+public:
+  void return_void() {
+    result_.set_value(util::detail::void_guard_tag{});
+  }
+};
+
+/// Resolves the given promise with the given value
+template <typename Promise>
+void resolve_promise(Promise&& promise, traits::identity<>,
+                     util::detail::void_guard_tag) {
+  std::forward<Promise>(promise).set_value();
+}
+template <typename Promise, typename T, typename Value>
+void resolve_promise(Promise&& promise, traits::identity<T>, Value&& value) {
+  std::forward<Promise>(promise).set_value(std::forward<Value>(value));
+}
+template <typename Promise, typename First, typename Second, typename... Rest,
+          typename Value>
+void resolve_promise(Promise&& promise,
+                     traits::identity<First, Second, Rest...>, Value&& value) {
+  traits::unpack(std::forward<Value>(value), [&](auto&&... args) {
+    std::forward<Promise>(promise).set_value(
+        std::forward<decltype(args)>(args)...);
+  });
+}
+
+/// The promise type of a coroutine which returns a continuable.
+///
+/// The coroutine is started lazily when the returned continuable is
+/// invoked, its result is passed to the promise of the continuation
+/// through `co_return` or `unhandled_exception`.
+///
+/// The frame of the coroutine is destroyed when the coroutine completed,
+/// since continuables are always invoked on destruction when they
+/// weren't frozen, a frozen but never invoked continuable leaks the frame.
+///
+/// \tparam Continuable The continuable type which is returned
+/// \tparam Promise The type erased promise which resolves the continuation
+template <typename Continuable, typename Promise, typename... Args>
+class promise_type
+    : public promise_return<typename util::detail::expected_result_trait<
+          traits::identity<Args...>>::expected_type> {
+
+  using handle_t = coroutine_handle<promise_type>;
+
+  /// The promise of the continuation, which is available after
+  /// the coroutine was started.
+  util::expected<Promise> promise_;
+
+  /// Starts the coroutine when the continuation is invoked
+  class starter {
+    handle_t handle_;
+
+  public:
+    explicit starter(handle_t handle) noexcept : handle_(handle) {
+    }
+
+    void operator()(Promise promise) {
+      handle_.promise().promise_.set_value(std::move(promise));
+      handle_.resume();
     }
   };
-}*/;
-} // namespace experimental
-} // namespace std
 
-#endif // CONTINUABLE_HAS_EXPERIMENTAL_COROUTINE
+  /// Destroys the frame and resolves the continuation when the
+  /// coroutine reached its final suspension point.
+  struct completion {
+    coroutine_handle<> operator()(handle_t handle) const noexcept {
+      Promise promise = std::move(handle.promise().promise_.get_value());
+      auto result = std::move(handle.promise().result_);
+      handle.destroy();
+
+      return transfer_resumption([&] {
+        if (result.is_value()) {
+          resolve_promise(std::move(promise), traits::identity<Args...>{},
+                          std::move(result.get_value()));
+        } else {
+          std::move(promise).set_exception(std::move(result.get_exception()));
+        }
+      });
+    }
+  };
+
+public:
+  static void* operator new(std::size_t size) {
+    return frame_allocator::allocate(size);
+  }
+
+  static void operator delete(void* frame, std::size_t size) noexcept {
+    frame_allocator::deallocate(frame, size);
+  }
+
+  Continuable get_return_object() {
+    return Continuable(starter(handle_t::from_promise(*this)));
+  }
+
+  suspend_always initial_suspend() noexcept {
+    return {};
+  }
+
+  transfer_awaiter<promise_type, completion> final_suspend() noexcept {
+    return {};
+  }
+
+  void unhandled_exception() noexcept {
+#if defined(CONTINUABLE_WITH_EXCEPTIONS)
+    this->result_.set_exception(std::current_exception());
+#else  // CONTINUABLE_WITH_EXCEPTIONS
+    util::trap();
+#endif // CONTINUABLE_WITH_EXCEPTIONS
+  }
+};
+} // namespace awaiting
+} // namespace detail
+} // namespace cti
+
+#endif // CONTINUABLE_HAS_COROUTINE
 #endif // CONTINUABLE_DETAIL_UTIL_HPP_INCLUDED__
@@ -116,6 +116,7 @@ struct attorney {
 // - ?                 -> next_callback(?)
 // - std::pair<?, ?>   -> next_callback(?, ?)
 // - std::tuple<?...>  -> next_callback(?...)
+// - forwarded_results<?...>  -> next_callback(?...)
 //
 // When the result is a continuation itself pass the callback to it
 // - continuation<?...> -> result(next_callback);
@@ -136,19 +137,62 @@ public:
   }
 };
 
+/// Invokes the body of an invoker directly, which is used when the callback
+/// can't throw an exception.
+template <typename Body, typename Callback, typename NextCallback,
+          typename... Args>
+void invoke_guarded(std::true_type /*is_nothrow*/, Body&& body,
+                    Callback&& callback, NextCallback&& next_callback,
+                    Args&&... args) {
+  std::forward<Body>(body)(std::forward<Callback>(callback),
+                           std::forward<NextCallback>(next_callback),
+                           std::forward<Args>(args)...);
+}
+
+/// Invokes the body of an invoker while forwarding exceptions thrown
+/// by the callback to the next callback.
+template <typename Body, typename Callback, typename NextCallback,
+          typename... Args>
+void invoke_guarded(std::false_type /*is_nothrow*/, Body&& body,
+                    Callback&& callback, NextCallback&& next_callback,
+                    Args&&... args) {
 #if defined(CONTINUABLE_WITH_EXCEPTIONS)
-#define CONTINUABLE_BLOCK_TRY_BEGIN try {
-#define CONTINUABLE_BLOCK_TRY_END                                              \
-  }                                                                            \
-  catch (...) {                                                                \
-    std::forward<decltype(next_callback)>(next_callback)(                      \
-        types::dispatch_error_tag{}, std::current_exception());                \
+  try {
+    std::forward<Body>(body)(std::forward<Callback>(callback),
+                             std::forward<NextCallback>(next_callback),
+                             std::forward<Args>(args)...);
+  } catch (...) {
+    std::forward<NextCallback>(next_callback)(types::dispatch_error_tag{},
+                                              std::current_exception());
   }
-
-#else // CONTINUABLE_WITH_EXCEPTIONS
-#define CONTINUABLE_BLOCK_TRY_BEGIN {
-#define CONTINUABLE_BLOCK_TRY_END }
+#else  // CONTINUABLE_WITH_EXCEPTIONS
+  invoke_guarded(std::true_type{}, std::forward<Body>(body),
+                 std::forward<Callback>(callback),
+                 std::forward<NextCallback>(next_callback),
+                 std::forward<Args>(args)...);
 #endif // CONTINUABLE_WITH_EXCEPTIONS
+}
+
+/// Wraps the body of an invoker such that exceptions of the callback
+/// are forwarded to the next callback.
+///
+/// The try/catch block is omitted at compile-time when the callback
+/// is `noexcept` for the given arguments, which makes the chain
+/// smaller and easier to inline.
+template <typename Body>
+constexpr auto make_guarded(Body body) {
+  return [body = std::move(body)](auto&& callback, auto&& next_callback,
+                                  auto&&... args) mutable {
+    util::is_nothrow_invokable<decltype(callback),
+                               std::tuple<decltype(args)...>>
+        is_nothrow;
+
+    invoke_guarded(is_nothrow, std::move(body),
+                   std::forward<decltype(callback)>(callback),
+                   std::forward<decltype(next_callback)>(next_callback),
+                   std::forward<decltype(args)>(args)...);
+  };
+}
 
 /// Invokes the given callable object with the given arguments while
 /// marking the operation as non exceptional.
@@ -174,17 +218,15 @@ invoker_of(traits::identity<continuable_base<Data, Annotation>>) {
   auto constexpr const hint = hints::hint_of(traits::identify<Type>{});
 
   return make_invoker(
-      [](auto&& callback, auto&& next_callback, auto&&... args) {
-        CONTINUABLE_BLOCK_TRY_BEGIN
-          auto continuation_ =
-              util::partial_invoke(std::forward<decltype(callback)>(callback),
-                                   std::forward<decltype(args)>(args)...);
-
-          attorney::invoke_continuation(
-              std::move(continuation_),
-              std::forward<decltype(next_callback)>(next_callback));
-        CONTINUABLE_BLOCK_TRY_END
-      },
+      make_guarded([](auto&& callback, auto&& next_callback, auto&&... args) {
+        auto continuation_ =
+            util::partial_invoke(std::forward<decltype(callback)>(callback),
+                                 std::forward<decltype(args)>(args)...);
+
+        attorney::invoke_continuation(
+            std::move(continuation_),
+            std::forward<decltype(next_callback)>(next_callback));
+      }),
       hint);
 }
 
@@ -192,56 +234,67 @@ invoker_of(traits::identity<continuable_base<Data, Annotation>>) {
 template <typename T>
 constexpr auto invoker_of(traits::identity<T>) {
   return make_invoker(
-      [](auto&& callback, auto&& next_callback, auto&&... args) {
-        CONTINUABLE_BLOCK_TRY_BEGIN
-          auto result =
-              util::partial_invoke(std::forward<decltype(callback)>(callback),
-                                   std::forward<decltype(args)>(args)...);
-
-          invoke_no_except(std::forward<decltype(next_callback)>(next_callback),
-                           std::move(result));
-        CONTINUABLE_BLOCK_TRY_END
-      },
+      make_guarded([](auto&& callback, auto&& next_callback, auto&&... args) {
+        // The result is passed as temporary into the next callback,
+        // which saves a move compared to storing it first.
+        invoke_no_except(
+            std::forward<decltype(next_callback)>(next_callback),
+            util::partial_invoke(std::forward<decltype(callback)>(callback),
+                                 std::forward<decltype(args)>(args)...));
+      }),
       traits::identify<T>{});
 }
 
 /// - void -> next_callback()
 inline auto invoker_of(traits::identity<void>) {
   return make_invoker(
-      [](auto&& callback, auto&& next_callback, auto&&... args) {
-        CONTINUABLE_BLOCK_TRY_BEGIN
-          util::partial_invoke(std::forward<decltype(callback)>(callback),
-                               std::forward<decltype(args)>(args)...);
-          invoke_no_except(
-              std::forward<decltype(next_callback)>(next_callback));
-        CONTINUABLE_BLOCK_TRY_END
-      },
+      make_guarded([](auto&& callback, auto&& next_callback, auto&&... args) {
+        util::partial_invoke(std::forward<decltype(callback)>(callback),
+                             std::forward<decltype(args)>(args)...);
+        invoke_no_except(std::forward<decltype(next_callback)>(next_callback));
+      }),
       traits::identity<>{});
 }
 
 /// Returns a sequenced invoker which is able to invoke
 /// objects where std::get is applicable.
 inline auto sequenced_unpack_invoker() {
-  return [](auto&& callback, auto&& next_callback, auto&&... args) {
-    CONTINUABLE_BLOCK_TRY_BEGIN
-      auto result =
-          util::partial_invoke(std::forward<decltype(callback)>(callback),
-                               std::forward<decltype(args)>(args)...);
-
-      // Workaround for MSVC not capturing the reference correctly inside
-      // the lambda.
-      using Next = decltype(next_callback);
-
-      traits::unpack(std::move(result), [&](auto&&... types) {
-        /// TODO Add inplace resolution here
-
-        invoke_no_except(std::forward<Next>(next_callback),
-                         std::forward<decltype(types)>(types)...);
-      });
-    CONTINUABLE_BLOCK_TRY_END
-  };
+  return make_guarded([](auto&& callback, auto&& next_callback,
+                         auto&&... args) {
+    auto result =
+        util::partial_invoke(std::forward<decltype(callback)>(callback),
+                             std::forward<decltype(args)>(args)...);
+
+    // Workaround for MSVC not capturing the reference correctly inside
+    // the lambda.
+    using Next = decltype(next_callback);
+
+    traits::unpack(std::move(result), [&](auto&&... types) {
+      // The elements are moved out of the returned tuple into the
+      // parameters of the next callback.
+      invoke_no_except(std::forward<Next>(next_callback),
+                       std::forward<decltype(types)>(types)...);
+    });
+  });
 } // namespace decoration
 
+/// Holds references to results which are owned by the callback of the
+/// current stage and thus outlive the invocation of the next callback.
+///
+/// Returning it from a stage constructs the referenced results directly
+/// inside the parameters of the next stage or the result slot of a
+/// composition, without materializing an intermediate tuple.
+template <typename... Args>
+struct forwarded_results {
+  std::tuple<Args...> results;
+};
+
+/// Creates a forwarded_results object from the given references
+template <typename... Args>
+constexpr forwarded_results<Args&&...> forward_results(Args&&... args) {
+  return {std::forward_as_tuple(std::forward<Args>(args)...)};
+}
+
 // - std::pair<?, ?> -> next_callback(?, ?)
 template <typename First, typename Second>
 constexpr auto invoker_of(traits::identity<std::pair<First, Second>>) {
@@ -255,8 +308,25 @@ constexpr auto invoker_of(traits::identity<std::tuple<Args...>>) {
   return make_invoker(sequenced_unpack_invoker(), traits::identity<Args...>{});
 }
 
-#undef CONTINUABLE_BLOCK_TRY_BEGIN
-#undef CONTINUABLE_BLOCK_TRY_END
+// - forwarded_results<?...>  -> next_callback(?...)
+template <typename... Args>
+constexpr auto invoker_of(traits::identity<forwarded_results<Args...>>) {
+  return make_invoker(
+      make_guarded([](auto&& callback, auto&& next_callback, auto&&... args) {
+        auto result =
+            util::partial_invoke(std::forward<decltype(callback)>(callback),
+                                 std::forward<decltype(args)>(args)...);
+
+        using Next = decltype(next_callback);
+
+        traits::unpack(std::move(result.results), [&](auto&&... types) {
+          invoke_no_except(std::forward<Next>(next_callback),
+                           std::forward<decltype(types)>(types)...);
+        });
+      }),
+      traits::identity<std::decay_t<Args>...>{});
+}
+
 } // namespace decoration
 
 /// Invoke the callback immediately
@@ -310,20 +380,30 @@ struct result_handler_base;
 template <typename Base, typename... Args>
 struct result_handler_base<handle_results::no, Base,
                            hints::signature_hint_tag<Args...>> {
-  void operator()(Args... args) && {
+  template <typename... PassedArgs,
+            types::enable_if_result_t<PassedArgs...>* = nullptr>
+  void operator()(PassedArgs&&... args) && {
     // Forward the arguments to the next callback
-    std::move(static_cast<Base*>(this)->next_callback_)(std::move(args)...);
+    std::move(static_cast<Base*>(this)->next_callback_)(
+        util::forward_as<Args>(std::forward<PassedArgs>(args))...);
   }
 };
 template <typename Base, typename... Args>
 struct result_handler_base<handle_results::yes, Base,
                            hints::signature_hint_tag<Args...>> {
   /// The operator which is called when the result was provided
-  void operator()(Args... args) && {
+  ///
+  /// The arguments are forwarded by reference down to the callback,
+  /// so a result is moved at most once from the producer into the
+  /// parameter of the consuming callback.
+  template <typename... PassedArgs,
+            types::enable_if_result_t<PassedArgs...>* = nullptr>
+  void operator()(PassedArgs&&... args) && {
     // In order to retrieve the correct decorator we must know what the
     // result type is.
     auto result = traits::identify<decltype(util::partial_invoke(
-        std::move(static_cast<Base*>(this)->callback_), std::move(args)...))>{};
+        std::move(static_cast<Base*>(this)->callback_),
+        std::declval<Args>()...))>{};
 
     // Pick the correct invoker that handles decorating of the result
     auto invoker = decoration::invoker_of(result);
@@ -333,7 +413,7 @@ struct result_handler_base<handle_results::yes, Base,
                     std::move(invoker),
                     std::move(static_cast<Base*>(this)->callback_),
                     std::move(static_cast<Base*>(this)->next_callback_),
-                    std::move(args)...);
+                    util::forward_as<Args>(std::forward<PassedArgs>(args))...);
   }
 };
 
@@ -422,8 +502,9 @@ struct callback_base<hints::signature_hint_tag<Args...>, HandleResults,
   operator();
 
   /// Resolves the continuation with the given values
-  void set_value(Args... args) {
-    std::move (*this)(std::move(args)...);
+  template <typename... PassedArgs>
+  void set_value(PassedArgs&&... args) {
+    std::move (*this)(std::forward<PassedArgs>(args)...);
   }
 
   /// Resolves the continuation with the given error variable.
@@ -448,11 +529,11 @@ auto make_callback(Callback&& callback, Executor&& executor,
 /// https://gcc.gnu.org/bugzilla/show_bug.cgi?id=64095
 struct final_callback {
   template <typename... Args>
-  void operator()(Args... /*args*/) && {
+  void operator()(Args&&... /*args*/) && {
   }
 
   template <typename... Args>
-  void set_value(Args... /*args*/) {
+  void set_value(Args&&... /*args*/) {
   }
 
   void set_exception(types::error_type error) {
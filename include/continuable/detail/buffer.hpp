@@ -0,0 +1,160 @@
+
+/*
+
+                        /~` _  _ _|_. _     _ |_ | _
+                        \_,(_)| | | || ||_|(_||_)|(/_
+
+                    https://github.com/Naios/continuable
+                                   v2.0.0
+
+  Copyright(c) 2015 - 2018 Denis Blank <denis.blank at outlook dot com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files(the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions :
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+**/
+
+#ifndef CONTINUABLE_DETAIL_BUFFER_HPP_INCLUDED__
+#define CONTINUABLE_DETAIL_BUFFER_HPP_INCLUDED__
+
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <utility>
+
+namespace cti {
+namespace detail {
+/// Provides the reference counted storage of buffer chains
+namespace buffer {
+/// A reference counted block of bytes which is shared between the
+/// slices which refer to it, the block is destroyed together with
+/// the last reference.
+class segment {
+  std::atomic<std::size_t> references_{1U};
+  void (*destroy_)(segment*);
+
+protected:
+  explicit segment(void (*destroy)(segment*)) noexcept
+      : destroy_(destroy) {
+  }
+  ~segment() = default;
+
+public:
+  segment(segment const&) = delete;
+  segment& operator=(segment const&) = delete;
+
+  void acquire() noexcept {
+    references_.fetch_add(1U, std::memory_order_relaxed);
+  }
+  void release() noexcept {
+    if (references_.fetch_sub(1U, std::memory_order_acq_rel) == 1U) {
+      destroy_(this);
+    }
+  }
+};
+
+/// A segment whose bytes are allocated together with it
+class heap_segment : public segment {
+  explicit heap_segment() noexcept : segment(&heap_segment::destroy) {
+  }
+
+  static void destroy(segment* current) noexcept {
+    heap_segment* const self = static_cast<heap_segment*>(current);
+    self->~heap_segment();
+    ::operator delete(static_cast<void*>(self));
+  }
+
+public:
+  /// Allocates a segment for the given count of bytes in one allocation
+  static heap_segment* allocate(std::size_t size) {
+    void* const storage = ::operator new(sizeof(heap_segment) + size);
+    return new (storage) heap_segment();
+  }
+
+  /// Returns the bytes which follow the segment
+  char* data() noexcept {
+    return reinterpret_cast<char*>(this + 1);
+  }
+};
+
+/// A segment which takes the ownership of a contiguous container,
+/// so its bytes are shared without copying them.
+template <typename Container>
+class adopted_segment : public segment {
+  Container container_;
+
+  static void destroy(segment* current) noexcept {
+    delete static_cast<adopted_segment*>(current);
+  }
+
+public:
+  explicit adopted_segment(Container container)
+      : segment(&adopted_segment::destroy), container_(std::move(container)) {
+  }
+
+  Container& container() noexcept {
+    return container_;
+  }
+};
+
+/// Refers to a segment and keeps it alive
+class segment_ref {
+  segment* segment_ = nullptr;
+
+public:
+  segment_ref() noexcept = default;
+  /// Adopts the reference which was created together with the segment
+  explicit segment_ref(segment* current) noexcept : segment_(current) {
+  }
+  segment_ref(segment_ref const& right) noexcept : segment_(right.segment_) {
+    if (segment_) {
+      segment_->acquire();
+    }
+  }
+  segment_ref(segment_ref&& right) noexcept
+      : segment_(std::exchange(right.segment_, nullptr)) {
+  }
+  segment_ref& operator=(segment_ref const& right) noexcept {
+    segment_ref(right).swap(*this);
+    return *this;
+  }
+  segment_ref& operator=(segment_ref&& right) noexcept {
+    segment_ref(std::move(right)).swap(*this);
+    return *this;
+  }
+  ~segment_ref() {
+    if (segment_) {
+      segment_->release();
+    }
+  }
+
+  void swap(segment_ref& right) noexcept {
+    std::swap(segment_, right.segment_);
+  }
+};
+
+/// A range of bytes inside of a segment which keeps the segment alive
+struct slice {
+  segment_ref owner;
+  char* data;
+  std::size_t size;
+};
+} // namespace buffer
+} // namespace detail
+} // namespace cti
+
+#endif // CONTINUABLE_DETAIL_BUFFER_HPP_INCLUDED__
@@ -32,8 +32,10 @@
 #define CONTINUABLE_DETAIL_COMPOSITION_HPP_INCLUDED__
 
 #include <atomic>
+#include <cassert>
 #include <memory>
 #include <mutex>
+#include <new>
 #include <tuple>
 #include <type_traits>
 #include <utility>
@@ -107,6 +109,37 @@ constexpr auto extract(traits::identity<T> /*type*/,
 } // namespace annotating
 
 namespace detail {
+/// Provides uninitialized storage for a single result of a composition,
+/// so the result can be constructed in place on arrival instead of
+/// being default constructed and assigned afterwards.
+template <typename T>
+class result_slot : public util::non_movable {
+  std::aligned_storage_t<sizeof(T), alignof(T)> storage_;
+  bool engaged_ = false;
+
+public:
+  constexpr result_slot() = default;
+  ~result_slot() {
+    if (engaged_) {
+      get().~T();
+    }
+  }
+
+  /// Constructs the result from the given value
+  template <typename V>
+  void emplace(V&& value) {
+    assert(!engaged_ && "The result was assigned twice!");
+    new (&storage_) T(std::forward<V>(value));
+    engaged_ = true;
+  }
+
+  /// Returns the result which was constructed before
+  T& get() noexcept {
+    assert(engaged_ && "The result wasn't assigned yet!");
+    return *reinterpret_cast<T*>(&storage_);
+  }
+};
+
 template <std::size_t Pos, typename T>
 constexpr void assign(traits::size_constant<Pos> /*pos*/, T& /*storage*/) {
   // ...
@@ -115,7 +148,7 @@ template <std::size_t Pos, typename T, typename Current, typename... Args>
 void assign(traits::size_constant<Pos> pos, T& storage, Current&& current,
             Args&&... args) {
   // TODO Improve this -> linear instantiation
-  std::get<Pos>(storage) = std::forward<Current>(current);
+  std::get<Pos>(storage).emplace(std::forward<Current>(current));
   assign(pos + traits::size_constant_of<1>(), storage,
          std::forward<Args>(args)...);
 }
@@ -130,7 +163,7 @@ class all_result_submitter : public std::enable_shared_from_this<
   T callback_;
   std::atomic<std::size_t> left_;
   std::once_flag flag_;
-  std::tuple<Args...> result_;
+  std::tuple<result_slot<Args>...> result_;
 
   template <std::size_t From, std::size_t To, typename... PartialArgs>
   void resolve(traits::size_constant<From> from, traits::size_constant<To>,
@@ -161,9 +194,10 @@ class all_result_submitter : public std::enable_shared_from_this<
   void invoke() {
     assert((left_ == 0U) && "Expected that the submitter is finished!");
     std::atomic_thread_fence(std::memory_order_acquire);
-    traits::unpack(std::move(result_), [&](auto&&... args) {
-      std::call_once(flag_, std::move(callback_),
-                     std::forward<decltype(args)>(args)...);
+    traits::unpack(result_, [&](auto&... slots) {
+      // The results are forwarded by reference, they are moved
+      // directly out of their slots into the callback.
+      std::call_once(flag_, std::move(callback_), std::move(slots.get())...);
     });
   }
   // Completes one result
@@ -338,6 +372,47 @@ struct entry_merger {
   }
 };
 
+/// Returns the merged signature hint of the given composition
+template <typename Composition>
+using signature_of_t = decltype(
+    traits::unpack(std::declval<Composition&>(), entry_merger{}));
+
+/// Invokes every continuation of the given `all` composition with the
+/// callback which is returned by the factory for the range
+/// `[from, to)` of the results the continuation submits.
+template <typename Composition, typename Factory>
+void invoke_composition(Composition& composition, Factory&& factory) {
+  // We mark the current 2-dimensional position through a pair:
+  // std::pair<size_constant<?>, size_constant<?>>
+  //           ~~~~~~~~~~~~~~~~  ~~~~~~~~~~~~~~~~
+  //           Continuation pos     Result pos
+  constexpr auto const begin = std::make_pair(traits::size_constant_of<0>(),
+                                              traits::size_constant_of<0>());
+  constexpr auto const pack = traits::identify<Composition>{};
+  constexpr auto const end = traits::pack_size_of(pack);
+  auto const condition = [=](auto pos) { return pos.first < end; };
+
+  // Invoke every continuation with it's callback of the submitter
+  traits::static_while(begin, condition, [&](auto current) mutable {
+    auto entry =
+        std::move(std::get<decltype(current.first)::value>(composition));
+
+    // This is the length of the arguments of the current continuable
+    constexpr auto const arg_size =
+        traits::pack_size_of(hints::hint_of(traits::identity_of(entry)));
+
+    // The next position in the result tuple
+    constexpr auto const next = current.second + arg_size;
+
+    // Invoke the continuation with the associated submission callback
+    base::attorney::invoke_continuation(std::move(entry),
+                                        factory(current.second, next));
+
+    return std::make_pair(current.first + traits::size_constant_of<1>(),
+                          next);
+  });
+}
+
 /// Finalizes the all logic of a given composition
 template <typename Data>
 auto finalize_composition(
@@ -353,40 +428,16 @@ auto finalize_composition(
   return base::attorney::create(
       [ signature,
         composition = std::move(composition) ](auto&& callback) mutable {
-        // We mark the current 2-dimensional position through a pair:
-        // std::pair<size_constant<?>, size_constant<?>>
-        //           ~~~~~~~~~~~~~~~~  ~~~~~~~~~~~~~~~~
-        //           Continuation pos     Result pos
-        constexpr auto const begin = std::make_pair(traits::size_constant_of<0>(),
-                                              traits::size_constant_of<0>());
         constexpr auto const pack = traits::identify<decltype(composition)>{};
         constexpr auto const end = traits::pack_size_of(pack);
-        auto const condition = [=](auto pos) { return pos.first < end; };
 
         // Create the result submitter which caches all results and invokes
         // the final callback upon completion.
         auto submitter = make_all_result_submitter(
             std::forward<decltype(callback)>(callback), end, signature);
 
-        // Invoke every continuation with it's callback of the submitter
-        traits::static_while(begin, condition, [&](auto current) mutable {
-          auto entry =
-              std::move(std::get<decltype(current.first)::value>(composition));
-
-          // This is the length of the arguments of the current continuable
-          constexpr auto const arg_size =
-              traits::pack_size_of(hints::hint_of(traits::identity_of(entry)));
-
-          // The next position in the result tuple
-          constexpr auto const next = current.second + arg_size;
-
-          // Invoke the continuation with the associated submission callback
-          base::attorney::invoke_continuation(
-              std::move(entry),
-              submitter->create_callback(current.second, next));
-
-          return std::make_pair(current.first + traits::size_constant_of<1>(),
-                                next);
+        invoke_composition(composition, [&](auto from, auto to) {
+          return submitter->create_callback(from, to);
         });
       },
       signature, std::move(ownership_));
@@ -494,9 +545,13 @@ auto sequential_connect(Left&& left, Right&& right) {
     return std::move(right).then([previous = std::make_tuple(
                                       std::forward<decltype(args)>(args)...)](
         auto&&... args) mutable {
-      return traits::merge(
-          std::move(previous),
-          std::make_tuple(std::forward<decltype(args)>(args)...));
+      // The results are moved directly out of the captured previous
+      // results and the current arguments into the next stage.
+      return traits::unpack(std::move(previous), [&](auto&&... prev) {
+        return base::decoration::forward_results(
+            std::forward<decltype(prev)>(prev)...,
+            std::forward<decltype(args)>(args)...);
+      });
     });
   });
 }
@@ -0,0 +1,291 @@
+
+/*
+
+                        /~` _  _ _|_. _     _ |_ | _
+                        \_,(_)| | | || ||_|(_||_)|(/_
+
+                    https://github.com/Naios/continuable
+                                   v2.0.0
+
+  Copyright(c) 2015 - 2018 Denis Blank <denis.blank at outlook dot com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files(the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions :
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+**/
+
+#ifndef CONTINUABLE_DETAIL_DIRECTORY_HPP_INCLUDED__
+#define CONTINUABLE_DETAIL_DIRECTORY_HPP_INCLUDED__
+
+#include <continuable/detail/features.hpp>
+
+// Exlude this header when getdents64 isn't available
+#ifdef CONTINUABLE_HAS_GETDENTS
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <continuable/detail/io.hpp>
+#include <continuable/detail/util.hpp>
+
+#ifdef CONTINUABLE_HAS_IO_URING
+#include <linux/stat.h>
+#include <sys/sysmacros.h>
+
+#include <continuable/detail/uring.hpp>
+#endif // CONTINUABLE_HAS_IO_URING
+
+namespace cti {
+namespace detail {
+/// Provides the bulk reading and the batched status retrieval
+/// of the directory walker
+namespace directory {
+/// The size of the buffer which receives the entries of a directory
+constexpr std::size_t buffer_size = 32U * 1024U;
+
+/// The offsets of the fields of the records which are returned by
+/// getdents64, since not every C library declares the record type.
+constexpr std::size_t record_inode = 0U;
+constexpr std::size_t record_length = 16U;
+constexpr std::size_t record_type = 18U;
+constexpr std::size_t record_name = 19U;
+
+/// Opens the directory for reading, returns an invalid descriptor
+/// and stores the `errno` value on failure.
+inline io::file_descriptor open_directory(char const* path, int& error) {
+  io::file_descriptor fd(::open(path, O_RDONLY | O_DIRECTORY | O_CLOEXEC));
+  if (!fd) {
+    error = errno;
+  }
+  return fd;
+}
+
+/// Reads the next entries of the directory into the buffer, returns the
+/// count of bytes read, which is zero at the end, or the negative `errno`
+/// value on failure.
+inline long read_entries(int fd, char* buffer, std::size_t size) noexcept {
+  for (;;) {
+    long const result = ::syscall(SYS_getdents64, fd, buffer, size);
+    if (result >= 0) {
+      return result;
+    }
+    if (errno != EINTR) {
+      return -errno;
+    }
+  }
+}
+
+/// Invokes the visitor with the inode, the type (`DT_*`) and the name of
+/// every entry in the buffer except for the `.` and `..` entries.
+template <typename Visitor>
+void for_each_entry(char const* buffer, std::size_t size, Visitor&& visitor) {
+  std::size_t offset = 0U;
+  while (offset + record_name <= size) {
+    // The fields are copied out since the records are packed
+    std::uint64_t inode;
+    unsigned short record;
+    unsigned char type;
+    std::memcpy(&inode, buffer + offset + record_inode, sizeof(inode));
+    std::memcpy(&record, buffer + offset + record_length, sizeof(record));
+    std::memcpy(&type, buffer + offset + record_type, sizeof(type));
+    if (record <= record_name) {
+      return;
+    }
+
+    char const* const name = buffer + offset + record_name;
+    std::size_t const length = ::strnlen(name, record - record_name);
+    bool const dots = (name[0] == '.') &&
+                      ((length == 1U) || ((length == 2U) && name[1] == '.'));
+    if (!dots) {
+      visitor(inode, type, name, length);
+    }
+    offset += record;
+  }
+}
+
+/// Retrieves the status of the given entry relative to the directory
+/// without following symbolic links, returns the `errno` value on failure.
+inline int stat_entry(int dirfd, char const* name, struct stat& status) {
+  if (::fstatat(dirfd, name, &status, AT_SYMLINK_NOFOLLOW) != 0) {
+    return errno;
+  }
+  return 0;
+}
+
+#ifdef CONTINUABLE_HAS_IO_URING
+/// Converts the result of a statx operation to a `struct stat`
+inline void to_stat(struct statx const& from, struct stat& to) noexcept {
+  std::memset(&to, 0, sizeof(to));
+  to.st_dev = makedev(from.stx_dev_major, from.stx_dev_minor);
+  to.st_ino = from.stx_ino;
+  to.st_mode = from.stx_mode;
+  to.st_nlink = from.stx_nlink;
+  to.st_uid = from.stx_uid;
+  to.st_gid = from.stx_gid;
+  to.st_rdev = makedev(from.stx_rdev_major, from.stx_rdev_minor);
+  to.st_size = static_cast<off_t>(from.stx_size);
+  to.st_blksize = static_cast<blksize_t>(from.stx_blksize);
+  to.st_blocks = static_cast<blkcnt_t>(from.stx_blocks);
+  to.st_atim.tv_sec = from.stx_atime.tv_sec;
+  to.st_atim.tv_nsec = from.stx_atime.tv_nsec;
+  to.st_mtim.tv_sec = from.stx_mtime.tv_sec;
+  to.st_mtim.tv_nsec = from.stx_mtime.tv_nsec;
+  to.st_ctim.tv_sec = from.stx_ctime.tv_sec;
+  to.st_ctim.tv_nsec = from.stx_ctime.tv_nsec;
+}
+#endif // CONTINUABLE_HAS_IO_URING
+
+/// Retrieves the status of many entries of a directory at once.
+///
+/// When io_uring is available the statx operations of up to batch_size
+/// entries are submitted and reaped through a single system call,
+/// otherwise or when the kernel doesn't support statx through io_uring
+/// the entries are examined one by one through `fstatat`.
+class status_batch : public util::non_movable {
+#ifdef CONTINUABLE_HAS_IO_URING
+  /// The ring is set up on first use and discarded when it isn't usable
+  std::unique_ptr<uring::ring> ring_;
+  bool usable_ = true;
+  std::vector<struct statx> results_;
+#endif // CONTINUABLE_HAS_IO_URING
+
+public:
+  /// The maximal count of operations which are submitted at once
+  static constexpr std::size_t batch_size = 64U;
+
+  status_batch() = default;
+
+  /// Retrieves the status of every entry, whose names start at the given
+  /// offset of their path, relative to the directory.
+  template <typename Entry>
+  void stat(int dirfd, Entry* entries, std::size_t count,
+            std::size_t name_offset) {
+    std::size_t done = 0U;
+#ifdef CONTINUABLE_HAS_IO_URING
+    while ((done < count) && usable()) {
+      std::size_t const size =
+          (count - done < batch_size) ? count - done : batch_size;
+      if (!submit(dirfd, entries + done, size, name_offset)) {
+        break;
+      }
+      done += size;
+    }
+#endif // CONTINUABLE_HAS_IO_URING
+
+    for (; done < count; ++done) {
+      Entry& entry = entries[done];
+      entry.status_error = stat_entry(
+          dirfd, entry.path.c_str() + name_offset, entry.status);
+    }
+  }
+
+private:
+#ifdef CONTINUABLE_HAS_IO_URING
+  bool usable() {
+    if (usable_ && !ring_) {
+#if defined(CONTINUABLE_WITH_EXCEPTIONS)
+      try {
+        ring_.reset(new uring::ring(static_cast<unsigned>(batch_size)));
+      } catch (...) {
+        usable_ = false;
+      }
+#else  // CONTINUABLE_WITH_EXCEPTIONS
+      // The setup traps on failure when exceptions are disabled,
+      // so the support of io_uring is probed first.
+      long const fd = ::syscall(__NR_io_uring_setup, 1U, nullptr);
+      usable_ = (fd >= 0) || (errno == EFAULT);
+      if (usable_) {
+        ring_.reset(new uring::ring(static_cast<unsigned>(batch_size)));
+      }
+#endif // CONTINUABLE_WITH_EXCEPTIONS
+      results_.resize(batch_size);
+    }
+    return usable_;
+  }
+
+  /// Retrieves the status of the entries through a batch of statx
+  /// operations, returns false when the ring isn't usable.
+  template <typename Entry>
+  bool submit(int dirfd, Entry* entries, std::size_t count,
+              std::size_t name_offset) {
+    for (std::size_t i = 0U; i < count; ++i) {
+      io_uring_sqe* const sqe = ring_->acquire();
+      if (!sqe) {
+        return discard();
+      }
+      sqe->opcode = IORING_OP_STATX;
+      sqe->fd = dirfd;
+      sqe->addr = reinterpret_cast<std::uint64_t>(entries[i].path.c_str() +
+                                                  name_offset);
+      sqe->len = STATX_BASIC_STATS;
+      sqe->off = reinterpret_cast<std::uint64_t>(&results_[i]);
+      sqe->statx_flags = AT_SYMLINK_NOFOLLOW;
+      sqe->user_data = i;
+      ring_->push();
+    }
+
+    std::size_t completed = 0U;
+    bool supported = true;
+    while (completed < count) {
+      int const result = ring_->wait();
+      if ((result < 0) && (result != -EAGAIN) && (result != -EBUSY)) {
+        return discard();
+      }
+      completed += ring_->reap([&](std::uint64_t index, std::int32_t status) {
+        Entry& entry = entries[index];
+        if (status == -EINVAL) {
+          // Kernels before 5.6 don't support statx through io_uring
+          supported = false;
+        } else if (status < 0) {
+          entry.status_error = -status;
+        } else {
+          entry.status_error = 0;
+          to_stat(results_[index], entry.status);
+        }
+      });
+    }
+    if (!supported) {
+      return discard();
+    }
+    return true;
+  }
+
+  /// Stops using the ring, where its teardown waits for the operations
+  /// which were submitted already.
+  bool discard() {
+    usable_ = false;
+    ring_.reset();
+    return false;
+  }
+#endif // CONTINUABLE_HAS_IO_URING
+};
+} // namespace directory
+} // namespace detail
+} // namespace cti
+
+#endif // CONTINUABLE_HAS_GETDENTS
+#endif // CONTINUABLE_DETAIL_DIRECTORY_HPP_INCLUDED__
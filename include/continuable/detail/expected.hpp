@@ -32,6 +32,7 @@
 #define CONTINUABLE_DETAIL_EXPECTED_HPP_INCLUDED__
 
 #include <cassert>
+#include <cstdint>
 #include <memory>
 #include <type_traits>
 #include <utility>
@@ -44,8 +45,23 @@
 namespace cti {
 namespace detail {
 namespace util {
+template <typename T>
+class expected;
+
 namespace detail {
-enum class slot_t { empty, value, error };
+/// The slot is stored in a single byte, so it can be placed next
+/// to small values without increasing the size of the expected.
+enum class slot_t : std::uint8_t { empty, value, error };
+
+/// Is true when the value and the error type are trivially copyable,
+/// in which case the expected is trivially copyable too and doesn't
+/// need to visit its content on copies, moves and destruction.
+template <typename T>
+using is_trivial_expected =
+    std::integral_constant<bool,
+                           std::is_trivially_copyable<T>::value &&
+                               std::is_trivially_copyable<types::error_type>::
+                                   value>;
 
 template <typename T>
 using storage_of_t = //
@@ -55,7 +71,7 @@ using storage_of_t = //
         (alignof(types::error_type) > alignof(T) ? alignof(types::error_type)
                                                  : alignof(T))>;
 
-template <typename T>
+template <typename T, bool IsTrivial = is_trivial_expected<T>::value>
 struct expected_base {
   storage_of_t<T> storage_;
   slot_t slot_;
@@ -73,6 +89,34 @@ struct expected_base {
   expected_base& operator=(expected_base&&) {
     return *this;
   }
+
+  ~expected_base() noexcept(
+      std::is_nothrow_destructible<T>::value&&
+          std::is_nothrow_destructible<types::error_type>::value) {
+    switch (slot_) {
+      case slot_t::value:
+        reinterpret_cast<T*>(&storage_)->~T();
+        break;
+      case slot_t::error: {
+        using error_type = types::error_type;
+        reinterpret_cast<error_type*>(&storage_)->~error_type();
+        break;
+      }
+      default:
+        // We don't destroy anything when there is no value
+        break;
+    }
+  }
+};
+/// The storage of trivially copyable expected objects,
+/// which is copied and destroyed implicitly.
+template <typename T>
+struct expected_base<T, true /*IsTrivial*/> {
+  storage_of_t<T> storage_;
+  slot_t slot_;
+
+  constexpr expected_base() : slot_(slot_t::empty) {
+  }
 };
 
 template <typename Base>
@@ -163,17 +207,26 @@ struct expected_copy_base<Base, false> : expected_move_base<Base> {
   expected_copy_base& operator=(expected_copy_base const&) = delete;
   expected_copy_base& operator=(expected_copy_base&& right) = default;
 };
+/// Trivially copyable expected objects are copied and moved
+/// through copying their storage.
+struct expected_trivial_copy_base {};
+
+template <typename T>
+using expected_copy_base_of = std::conditional_t<
+    is_trivial_expected<T>::value, expected_trivial_copy_base,
+    expected_copy_base<expected<T>,
+                       std::is_copy_constructible<types::error_type>::value &&
+                           std::is_copy_constructible<T>::value>>;
 } // namespace detail
 
 /// A class similar to the one in the expected proposal,
 /// however it is capable of carrying an exception_ptr if
 /// exceptions are used.
+///
+/// When the value and the error type are trivially copyable,
+/// the expected is trivially copyable as well.
 template <typename T>
-class expected
-    : detail::expected_copy_base<
-          expected<T>, std::is_copy_constructible<types::error_type>::value &&
-                           std::is_copy_constructible<T>::value>,
-      detail::expected_base<T> {
+class expected : detail::expected_copy_base_of<T>, detail::expected_base<T> {
 
   template <typename>
   friend class expected;
@@ -196,12 +249,6 @@ public:
   expected& operator=(expected const&) = default;
   expected& operator=(expected&&) = default;
 
-  ~expected() noexcept(
-      std::is_nothrow_destructible<T>::value&&
-          std::is_nothrow_destructible<types::error_type>::value) {
-    weak_destroy();
-  }
-
   explicit expected(T value) //
       : expected(std::move(value), detail::slot_t::value) {
   }
@@ -363,7 +410,7 @@ struct expected_result_trait<traits::identity<T>> {
   using expected_type = expected<T>;
 
   static auto wrap(T arg) {
-    return std::move(arg);
+    return arg;
   }
   static auto unwrap(expected_type&& e) {
     assert(e.is_value());
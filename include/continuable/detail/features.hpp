@@ -70,4 +70,54 @@
 /// This is enabled by the CMake project
 // #undef CONTINUABLE_HAS_EXPERIMENTAL_COROUTINE
 
+/// Define CONTINUABLE_HAS_COROUTINE when either the coroutine TS
+/// or standard C++20 coroutines are available.
+#if defined(CONTINUABLE_HAS_EXPERIMENTAL_COROUTINE)
+#define CONTINUABLE_HAS_COROUTINE 1
+#elif defined(__cpp_impl_coroutine) && (__cpp_impl_coroutine >= 201902L)
+#if defined(__has_include)
+#if __has_include(<coroutine>)
+#define CONTINUABLE_HAS_COROUTINE 1
+#endif
+#endif
+#endif
+
+/// Define CONTINUABLE_HAS_FIBERS when the stackful fiber scheduler is
+/// available, which switches contexts on Linux x86-64 only.
+#if defined(__linux__) && defined(__x86_64__) && defined(__GNUC__)
+#define CONTINUABLE_HAS_FIBERS 1
+#endif
+
+/// Define CONTINUABLE_HAS_EPOLL when the epoll interface
+/// of the Linux kernel is available.
+#if defined(__linux__)
+#define CONTINUABLE_HAS_EPOLL 1
+#endif
+
+/// Define CONTINUABLE_HAS_MMAP when files can be mapped into memory
+/// through the POSIX mmap interface.
+#if defined(__unix__)
+#define CONTINUABLE_HAS_MMAP 1
+#endif
+
+/// Define CONTINUABLE_HAS_IO_URING when the io_uring interface
+/// of the Linux kernel is available.
+///
+/// The read, write and statx operations require the headers of Linux 5.6,
+/// older headers already provide <linux/io_uring.h> without them.
+#if defined(__linux__) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>) && __has_include(<linux/version.h>)
+#include <linux/version.h>
+#if LINUX_VERSION_CODE >= KERNEL_VERSION(5, 6, 0)
+#define CONTINUABLE_HAS_IO_URING 1
+#endif
+#endif
+#endif
+
+/// Define CONTINUABLE_HAS_GETDENTS when directories can be read in bulk
+/// through the getdents64 system call of the Linux kernel.
+#if defined(__linux__)
+#define CONTINUABLE_HAS_GETDENTS 1
+#endif
+
 #endif // CONTINUABLE_DETAIL_FEATURES_HPP_INCLUDED__
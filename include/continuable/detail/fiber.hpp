@@ -0,0 +1,415 @@
+
+/*
+
+                        /~` _  _ _|_. _     _ |_ | _
+                        \_,(_)| | | || ||_|(_||_)|(/_
+
+                    https://github.com/Naios/continuable
+                                   v2.0.0
+
+  Copyright(c) 2015 - 2018 Denis Blank <denis.blank at outlook dot com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files(the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions :
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+**/
+
+#ifndef CONTINUABLE_DETAIL_FIBER_HPP_INCLUDED__
+#define CONTINUABLE_DETAIL_FIBER_HPP_INCLUDED__
+
+#include <continuable/detail/features.hpp>
+
+// Exlude this header when fibers are not available
+#ifdef CONTINUABLE_HAS_FIBERS
+
+#include <atomic>
+#include <cassert>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <new>
+#include <system_error>
+#include <utility>
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <continuable/continuable-api.hpp>
+#include <continuable/detail/base.hpp>
+#include <continuable/detail/expected.hpp>
+#include <continuable/detail/hints.hpp>
+#include <continuable/detail/types.hpp>
+#include <continuable/detail/util.hpp>
+
+#if defined(CONTINUABLE_WITH_EXCEPTIONS)
+#include <exception>
+#endif // CONTINUABLE_WITH_EXCEPTIONS
+
+namespace cti {
+namespace detail {
+/// Provides a stackful fiber scheduler with hand-rolled context switching
+namespace fiber {
+/// Saves the callee saved registers and the floating point control words
+/// of the current context on its stack, stores its stack pointer
+/// into `from` and continues the context which is stored in `to`.
+__attribute__((naked, noinline)) inline void
+switch_context(void** /*from*/, void* /*to*/) noexcept {
+  __asm__ volatile("pushq %rbp\n\t"
+                   "pushq %rbx\n\t"
+                   "pushq %r12\n\t"
+                   "pushq %r13\n\t"
+                   "pushq %r14\n\t"
+                   "pushq %r15\n\t"
+                   "subq $8, %rsp\n\t"
+                   "stmxcsr (%rsp)\n\t"
+                   "fnstcw 4(%rsp)\n\t"
+                   "movq %rsp, (%rdi)\n\t"
+                   "movq %rsi, %rsp\n\t"
+                   "ldmxcsr (%rsp)\n\t"
+                   "fldcw 4(%rsp)\n\t"
+                   "addq $8, %rsp\n\t"
+                   "popq %r15\n\t"
+                   "popq %r14\n\t"
+                   "popq %r13\n\t"
+                   "popq %r12\n\t"
+                   "popq %rbx\n\t"
+                   "popq %rbp\n\t"
+                   "ret\n\t");
+}
+
+/// The first function which is executed on a new context,
+/// it calls the entry function in r13 with the argument in r12.
+__attribute__((naked, noinline)) inline void trampoline() noexcept {
+  __asm__ volatile("movq %r12, %rdi\n\t"
+                   "callq *%r13\n\t"
+                   "ud2\n\t");
+}
+
+/// A stack which is mapped with a guard page below it
+class stack : public util::non_copyable {
+  void* memory_ = nullptr;
+  std::size_t size_ = 0U;
+
+public:
+  stack() = default;
+  explicit stack(std::size_t size) {
+    std::size_t const page = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+    size_ = ((size + page - 1U) / page + 1U) * page;
+
+    memory_ = ::mmap(nullptr, size_, PROT_READ | PROT_WRITE,
+                     MAP_PRIVATE | MAP_ANONYMOUS | MAP_STACK, -1, 0);
+    if (memory_ == MAP_FAILED) {
+      memory_ = nullptr;
+#if defined(CONTINUABLE_WITH_EXCEPTIONS)
+      throw std::bad_alloc();
+#else  // CONTINUABLE_WITH_EXCEPTIONS
+      util::trap();
+#endif // CONTINUABLE_WITH_EXCEPTIONS
+    }
+    // The guard page traps stack overflows
+    ::mprotect(memory_, page, PROT_NONE);
+  }
+  stack(stack&& right) noexcept
+      : memory_(std::exchange(right.memory_, nullptr)),
+        size_(std::exchange(right.size_, 0U)) {
+  }
+  stack& operator=(stack&& right) noexcept {
+    std::swap(memory_, right.memory_);
+    std::swap(size_, right.size_);
+    return *this;
+  }
+  ~stack() {
+    if (memory_) {
+      ::munmap(memory_, size_);
+    }
+  }
+
+  /// Returns the highest address of the stack
+  void* top() const noexcept {
+    return static_cast<char*>(memory_) + size_;
+  }
+};
+
+class scheduler;
+
+/// The type independent part of a fiber
+class fiber_base : public util::non_movable {
+  friend class scheduler;
+
+  using entry_t = void (*)(fiber_base*);
+
+  /// The saved stack pointer while the fiber isn't running
+  void* sp_ = nullptr;
+  stack stack_;
+  scheduler* scheduler_;
+  bool finished_ = false;
+#if defined(CONTINUABLE_WITH_EXCEPTIONS)
+  /// The exception which escaped the fiber
+  std::exception_ptr exception_;
+#endif // CONTINUABLE_WITH_EXCEPTIONS
+
+  static void entry(fiber_base* me);
+
+protected:
+  fiber_base(scheduler* owner, std::size_t stack_size)
+      : stack_(stack_size), scheduler_(owner) {
+    // Lay out the initial frame which is restored by switch_context,
+    // the trampoline is entered with a 16 byte aligned stack.
+    auto top = reinterpret_cast<std::uintptr_t>(stack_.top()) &
+               ~std::uintptr_t(15U);
+    auto frame = reinterpret_cast<std::uint64_t*>(top) - 8U;
+
+    std::uint32_t const mxcsr = 0x1F80U;
+    std::uint16_t const fpucw = 0x037FU;
+    std::memcpy(frame, &mxcsr, sizeof(mxcsr));
+    std::memcpy(reinterpret_cast<char*>(frame) + 4U, &fpucw, sizeof(fpucw));
+    frame[1] = 0U; // r15
+    frame[2] = 0U; // r14
+    frame[3] = reinterpret_cast<std::uint64_t>(&fiber_base::entry); // r13
+    frame[4] = reinterpret_cast<std::uint64_t>(this);               // r12
+    frame[5] = 0U;                                                  // rbx
+    frame[6] = 0U;                                                  // rbp
+    frame[7] = reinterpret_cast<std::uint64_t>(&trampoline);        // ret
+    sp_ = frame;
+  }
+
+public:
+  virtual ~fiber_base() = default;
+
+  /// Runs the body of the fiber
+  virtual void run() = 0;
+
+  /// Parks the fiber and switches back to its scheduler
+  void park() noexcept;
+  /// Schedules the parked fiber for resumption, this is thread safe
+  void unpark();
+};
+
+/// A fiber which runs the given callable object
+template <typename T>
+class fiber_of : public fiber_base {
+  T callable_;
+
+public:
+  fiber_of(scheduler* owner, std::size_t stack_size, T callable)
+      : fiber_base(owner, stack_size), callable_(std::move(callable)) {
+  }
+
+  void run() override {
+    std::move(callable_)();
+  }
+};
+
+/// Returns the fiber which is running on the current thread
+inline fiber_base*& current() noexcept {
+  static thread_local fiber_base* fiber = nullptr;
+  return fiber;
+}
+
+/// Runs fibers on the thread which calls scheduler::run
+class scheduler : public util::non_movable {
+  friend class fiber_base;
+
+  std::size_t stack_size_;
+  /// The saved stack pointer of the thread which runs the scheduler
+  void* sp_ = nullptr;
+  /// The count of fibers which didn't finish yet
+  std::size_t alive_ = 0U;
+
+  std::mutex mutex_;
+  std::condition_variable condition_;
+  /// The fibers which are ready to run
+  std::deque<fiber_base*> ready_;
+
+  void schedule(fiber_base* fiber) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      ready_.push_back(fiber);
+    }
+    condition_.notify_one();
+  }
+
+  fiber_base* pop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    condition_.wait(lock, [&] { return !ready_.empty(); });
+    fiber_base* fiber = ready_.front();
+    ready_.pop_front();
+    return fiber;
+  }
+
+public:
+  explicit scheduler(std::size_t stack_size) : stack_size_(stack_size) {
+  }
+
+  ~scheduler() {
+    assert(!alive_ && "The scheduler was destroyed while fibers are alive!");
+  }
+
+  /// Creates a fiber which runs the given callable object
+  template <typename T>
+  void spawn(T&& callable) {
+    fiber_base* fiber = new fiber_of<std::decay_t<T>>(
+        this, stack_size_, std::forward<T>(callable));
+    ++alive_;
+    schedule(fiber);
+  }
+
+  /// Runs the fibers until all of them finished
+  void run() {
+#if defined(CONTINUABLE_WITH_EXCEPTIONS)
+    // Parked fibers can't be destroyed safely because their stack is
+    // referenced by the continuations they are waiting for, thus the
+    // remaining fibers are drained before the first exception is rethrown.
+    std::exception_ptr exception;
+#endif // CONTINUABLE_WITH_EXCEPTIONS
+
+    while (alive_) {
+      fiber_base* fiber = pop();
+
+      fiber_base* const previous = std::exchange(current(), fiber);
+      switch_context(&sp_, fiber->sp_);
+      current() = previous;
+
+      if (fiber->finished_) {
+        --alive_;
+#if defined(CONTINUABLE_WITH_EXCEPTIONS)
+        if (!exception) {
+          exception = std::move(fiber->exception_);
+        }
+#endif // CONTINUABLE_WITH_EXCEPTIONS
+        delete fiber;
+      }
+    }
+
+#if defined(CONTINUABLE_WITH_EXCEPTIONS)
+    if (exception) {
+      std::rethrow_exception(std::move(exception));
+    }
+#endif // CONTINUABLE_WITH_EXCEPTIONS
+  }
+};
+
+inline void fiber_base::entry(fiber_base* me) {
+#if defined(CONTINUABLE_WITH_EXCEPTIONS)
+  try {
+    me->run();
+  } catch (...) {
+    me->exception_ = std::current_exception();
+  }
+#else  // CONTINUABLE_WITH_EXCEPTIONS
+  me->run();
+#endif // CONTINUABLE_WITH_EXCEPTIONS
+
+  me->finished_ = true;
+  me->park();
+  util::unreachable();
+}
+
+inline void fiber_base::park() noexcept {
+  switch_context(&sp_, scheduler_->sp_);
+}
+
+inline void fiber_base::unpark() {
+  scheduler_->schedule(this);
+}
+
+/// Resolves the result of an awaited continuation and resumes the
+/// fiber if it was parked already.
+template <typename Trait>
+class fiber_callback {
+  typename Trait::expected_type* result_;
+  std::atomic<bool>* completed_;
+  fiber_base* fiber_;
+
+public:
+  fiber_callback(typename Trait::expected_type* result,
+                 std::atomic<bool>* completed, fiber_base* fiber)
+      : result_(result), completed_(completed), fiber_(fiber) {
+  }
+
+  template <typename... Args, types::enable_if_result_t<Args...>* = nullptr>
+  void operator()(Args&&... args) {
+    result_->set_value(Trait::wrap(std::forward<Args>(args)...));
+    complete();
+  }
+
+  void operator()(types::dispatch_error_tag, types::error_type error) {
+    result_->set_exception(std::move(error));
+    complete();
+  }
+
+private:
+  void complete() {
+    // Only unpark the fiber when it was parked already,
+    // otherwise it continues without being parked at all.
+    if (completed_->exchange(true, std::memory_order_acq_rel)) {
+      fiber_->unpark();
+    }
+  }
+};
+
+/// Parks the current fiber until the given continuable was resolved
+/// and returns its result as expected object
+template <typename Continuable>
+auto await_expected(Continuable&& continuable) {
+  fiber_base* const fiber = current();
+  assert(fiber && "Awaited a continuable outside of a fiber!");
+
+  using trait_t = util::expected_result_trait_t<Continuable>;
+
+  // The result is stored on the stack of the fiber
+  typename trait_t::expected_type result;
+  std::atomic<bool> completed{false};
+
+  std::move(continuable)
+      .next(fiber_callback<trait_t>(&result, &completed, fiber))
+      .done();
+
+  if (!completed.exchange(true, std::memory_order_acq_rel)) {
+    fiber->park();
+  }
+  return result;
+}
+
+/// Parks the current fiber until the given continuable was resolved
+/// and returns its unwrapped result or throws its error
+template <typename Continuable>
+auto await(Continuable&& continuable) {
+  using trait_t = util::expected_result_trait_t<Continuable>;
+
+  auto result = await_expected(std::move(continuable));
+  if (result) {
+    return trait_t::unwrap(std::move(result));
+  }
+
+#if defined(CONTINUABLE_WITH_EXCEPTIONS)
+  std::rethrow_exception(result.get_exception());
+#else  // CONTINUABLE_WITH_EXCEPTIONS
+  // Returning error types in await isn't supported,
+  // use await_expected instead.
+  util::trap();
+#endif // CONTINUABLE_WITH_EXCEPTIONS
+}
+} // namespace fiber
+} // namespace detail
+} // namespace cti
+
+#endif // CONTINUABLE_HAS_FIBERS
+#endif // CONTINUABLE_DETAIL_FIBER_HPP_INCLUDED__
@@ -0,0 +1,267 @@
+
+/*
+
+                        /~` _  _ _|_. _     _ |_ | _
+                        \_,(_)| | | || ||_|(_||_)|(/_
+
+                    https://github.com/Naios/continuable
+                                   v2.0.0
+
+  Copyright(c) 2015 - 2018 Denis Blank <denis.blank at outlook dot com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files(the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions :
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+**/
+
+#ifndef CONTINUABLE_DETAIL_GENERATOR_HPP_INCLUDED__
+#define CONTINUABLE_DETAIL_GENERATOR_HPP_INCLUDED__
+
+#include <continuable/detail/features.hpp>
+
+// Exlude this header when coroutines are not available
+#ifdef CONTINUABLE_HAS_COROUTINE
+
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#include <continuable/continuable-api.hpp>
+#include <continuable/detail/awaiting.hpp>
+#include <continuable/detail/base.hpp>
+#include <continuable/detail/expected.hpp>
+#include <continuable/detail/hints.hpp>
+#include <continuable/detail/types.hpp>
+#include <continuable/detail/util.hpp>
+
+#if defined(CONTINUABLE_WITH_EXCEPTIONS)
+#include <exception>
+#endif // CONTINUABLE_WITH_EXCEPTIONS
+
+namespace cti {
+namespace detail {
+namespace awaiting {
+#ifndef NDEBUG
+/// Tracks the lifetime of a generator, so continuables which are invoked
+/// after the generator was destroyed are detected in debug builds.
+class generator_lifetime {
+  std::shared_ptr<bool> alive_ = std::make_shared<bool>(true);
+
+public:
+  class observer {
+    std::weak_ptr<bool> alive_;
+
+  public:
+    explicit observer(std::weak_ptr<bool> alive) : alive_(std::move(alive)) {
+    }
+
+    void check() const noexcept {
+      assert(!alive_.expired() &&
+             "The generator was destroyed before next() was invoked!");
+    }
+  };
+
+  observer observe() const {
+    return observer(alive_);
+  }
+};
+#else  // NDEBUG
+class generator_lifetime {
+public:
+  struct observer {
+    void check() const noexcept {
+    }
+  };
+
+  observer observe() const noexcept {
+    return {};
+  }
+};
+#endif // NDEBUG
+
+/// A coroutine which produces its elements lazily through `co_yield`,
+/// the elements are pulled through a continuable.
+///
+/// \tparam T The type of the elements
+/// \tparam Promise The type erased promise which resolves the consumer
+template <typename T, typename Promise>
+class async_generator : public util::non_copyable {
+  static_assert(!std::is_reference<T>::value,
+                "The elements of a generator can't be references!");
+
+public:
+  class promise_type {
+    using handle_t = coroutine_handle<promise_type>;
+
+    /// The promise of the consumer which pulls the next element
+    util::expected<Promise> consumer_;
+    /// The element which was yielded currently, it lives inside the
+    /// frame of the suspended coroutine until the next element is pulled.
+    T* current_ = nullptr;
+    /// Is set when the coroutine exited with an error
+    bool failed_ = false;
+    /// The error the coroutine exited with
+    types::error_type error_;
+
+    Promise take_consumer() {
+      return std::move(consumer_.get_value());
+    }
+
+    /// Hands the yielded element over to the consumer
+    struct yield_completion {
+      coroutine_handle<> operator()(handle_t handle) const noexcept {
+        promise_type& me = handle.promise();
+        return transfer_resumption(
+            [&] { me.take_consumer().set_value(me.current_); });
+      }
+    };
+
+    /// Resolves the consumer with the end of the sequence,
+    /// or the error the coroutine exited with.
+    struct final_completion {
+      coroutine_handle<> operator()(handle_t handle) const noexcept {
+        promise_type& me = handle.promise();
+        return transfer_resumption([&] {
+          if (me.failed_) {
+            me.take_consumer().set_exception(std::move(me.error_));
+          } else {
+            me.take_consumer().set_value(nullptr);
+          }
+        });
+      }
+    };
+
+  public:
+    static void* operator new(std::size_t size) {
+      return frame_allocator::allocate(size);
+    }
+
+    static void operator delete(void* frame, std::size_t size) noexcept {
+      frame_allocator::deallocate(frame, size);
+    }
+
+    async_generator get_return_object() noexcept {
+      return async_generator(handle_t::from_promise(*this));
+    }
+
+    suspend_always initial_suspend() noexcept {
+      return {};
+    }
+
+    transfer_awaiter<promise_type, final_completion> final_suspend() noexcept {
+      return {};
+    }
+
+    transfer_awaiter<promise_type, yield_completion>
+    yield_value(T& value) noexcept {
+      current_ = std::addressof(value);
+      return {};
+    }
+    transfer_awaiter<promise_type, yield_completion>
+    yield_value(T&& value) noexcept {
+      current_ = std::addressof(value);
+      return {};
+    }
+
+    void return_void() noexcept {
+    }
+
+    void unhandled_exception() noexcept {
+#if defined(CONTINUABLE_WITH_EXCEPTIONS)
+      failed_ = true;
+      error_ = std::current_exception();
+#else  // CONTINUABLE_WITH_EXCEPTIONS
+      util::trap();
+#endif // CONTINUABLE_WITH_EXCEPTIONS
+    }
+
+    /// Resumes the coroutine until it yields the next element
+    void pull(handle_t handle, Promise consumer) {
+      consumer_.set_value(std::move(consumer));
+      current_ = nullptr;
+      handle.resume();
+    }
+  };
+
+  async_generator(async_generator&& right) noexcept
+      : handle_(std::exchange(right.handle_, nullptr)),
+        lifetime_(std::move(right.lifetime_)) {
+  }
+  async_generator& operator=(async_generator&& right) noexcept {
+    if (this != &right) {
+      reset();
+      handle_ = std::exchange(right.handle_, nullptr);
+      lifetime_ = std::move(right.lifetime_);
+    }
+    return *this;
+  }
+  ~async_generator() {
+    reset();
+  }
+
+  /// Returns a continuable which resumes the generator until it yields
+  /// the next element, the continuable is resolved with a pointer
+  /// to the element or a `nullptr` when the generator ended.
+  ///
+  /// The element stays valid until the next element is pulled or the
+  /// generator is destroyed. Only one element may be pulled at the time.
+  ///
+  /// \attention The continuable refers to the frame of the generator,
+  ///            thus it must be invoked and resolved while the generator
+  ///            is alive, which is asserted in debug builds.
+  auto next() {
+    return base::attorney::create(
+        [handle = handle_, lifetime = lifetime_.observe()](auto&& promise) {
+          if (!handle) {
+            promise.set_value(nullptr);
+            return;
+          }
+          lifetime.check();
+          if (handle.done()) {
+            promise.set_value(nullptr);
+            return;
+          }
+
+          handle.promise().pull(
+              handle, Promise(std::forward<decltype(promise)>(promise)));
+        },
+        hints::signature_hint_tag<T*>{}, util::ownership{});
+  }
+
+private:
+  explicit async_generator(coroutine_handle<promise_type> handle) noexcept
+      : handle_(handle) {
+  }
+
+  void reset() noexcept {
+    if (handle_) {
+      handle_.destroy();
+      handle_ = nullptr;
+    }
+  }
+
+  coroutine_handle<promise_type> handle_;
+  generator_lifetime lifetime_;
+};
+} // namespace awaiting
+} // namespace detail
+} // namespace cti
+
+#endif // CONTINUABLE_HAS_COROUTINE
+#endif // CONTINUABLE_DETAIL_GENERATOR_HPP_INCLUDED__
@@ -0,0 +1,185 @@
+
+/*
+
+                        /~` _  _ _|_. _     _ |_ | _
+                        \_,(_)| | | || ||_|(_||_)|(/_
+
+                    https://github.com/Naios/continuable
+                                   v2.0.0
+
+  Copyright(c) 2015 - 2018 Denis Blank <denis.blank at outlook dot com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files(the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions :
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+**/
+
+#ifndef CONTINUABLE_DETAIL_IO_HPP_INCLUDED__
+#define CONTINUABLE_DETAIL_IO_HPP_INCLUDED__
+
+#include <cassert>
+#include <new>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#include <continuable/detail/features.hpp>
+#include <continuable/detail/types.hpp>
+#include <continuable/detail/util.hpp>
+
+#if defined(CONTINUABLE_WITH_EXCEPTIONS)
+#include <exception>
+#endif // CONTINUABLE_WITH_EXCEPTIONS
+
+#if defined(__unix__)
+#include <unistd.h>
+#endif // __unix__
+
+namespace cti {
+namespace detail {
+/// Provides helpers shared by the asynchronous I/O facilities
+namespace io {
+/// Converts the given `errno` value to the current error type.
+///
+/// The hybrid error type carries the error code inline,
+/// otherwise a `std::system_error` is created when exceptions are enabled.
+/// Custom error types are required to be constructible from
+/// a `std::error_code`.
+inline types::error_type make_system_error(int error) {
+#if defined(CONTINUABLE_WITH_CUSTOM_ERROR_TYPE) ||                             \
+    defined(CONTINUABLE_WITH_HYBRID_ERROR_TYPE)
+  return types::error_type(std::error_code(error, std::system_category()));
+#elif defined(CONTINUABLE_WITH_EXCEPTIONS)
+  return std::make_exception_ptr(
+      std::system_error(error, std::system_category()));
+#else
+  return std::error_condition(error, std::generic_category());
+#endif
+}
+
+/// Converts the given error code to the current error type,
+/// like make_system_error for an `errno` value.
+inline types::error_type make_system_error(std::error_code const& code) {
+#if defined(CONTINUABLE_WITH_CUSTOM_ERROR_TYPE) ||                             \
+    defined(CONTINUABLE_WITH_HYBRID_ERROR_TYPE)
+  return types::error_type(code);
+#elif defined(CONTINUABLE_WITH_EXCEPTIONS)
+  return std::make_exception_ptr(std::system_error(code));
+#else
+  return std::error_condition(code.value(), code.category());
+#endif
+}
+
+/// Reports a failure of a setup routine, by throwing a `std::system_error`
+/// or trapping when exceptions are disabled.
+[[noreturn]] inline void throw_system_error(int error, char const* what) {
+#if defined(CONTINUABLE_WITH_EXCEPTIONS)
+  throw std::system_error(error, std::system_category(), what);
+#else  // CONTINUABLE_WITH_EXCEPTIONS
+  (void)error;
+  (void)what;
+  util::trap();
+#endif // CONTINUABLE_WITH_EXCEPTIONS
+}
+
+/// Provides storage for an object which is present optionally,
+/// like an operation which is pending until its descriptor is ready.
+template <typename T>
+class pending : public util::non_movable {
+  std::aligned_storage_t<sizeof(T), alignof(T)> storage_;
+  bool engaged_ = false;
+
+  T& get() noexcept {
+    return *reinterpret_cast<T*>(&storage_);
+  }
+
+public:
+  pending() = default;
+  ~pending() {
+    if (engaged_) {
+      get().~T();
+    }
+  }
+
+  /// Returns true when an object is stored
+  bool has_value() const noexcept {
+    return engaged_;
+  }
+
+  /// Stores the given object
+  template <typename... Args>
+  void emplace(Args&&... args) {
+    assert(!engaged_ && "The object is stored already!");
+    new (&storage_) T(std::forward<Args>(args)...);
+    engaged_ = true;
+  }
+
+  /// Returns the object which is stored
+  T* operator->() noexcept {
+    assert(engaged_ && "No object is stored!");
+    return &get();
+  }
+
+  /// Moves the stored object out and releases the storage
+  T take() {
+    assert(engaged_ && "No object is stored!");
+    T object = std::move(get());
+    get().~T();
+    engaged_ = false;
+    return object;
+  }
+};
+
+#if defined(__unix__)
+/// Owns a file descriptor and closes it on destruction
+class file_descriptor {
+  int fd_ = -1;
+
+public:
+  file_descriptor() = default;
+  explicit file_descriptor(int fd) noexcept : fd_(fd) {
+  }
+  file_descriptor(file_descriptor&& right) noexcept
+      : fd_(std::exchange(right.fd_, -1)) {
+  }
+  file_descriptor& operator=(file_descriptor&& right) noexcept {
+    std::swap(fd_, right.fd_);
+    return *this;
+  }
+  file_descriptor(file_descriptor const&) = delete;
+  file_descriptor& operator=(file_descriptor const&) = delete;
+  ~file_descriptor() {
+    if (fd_ >= 0) {
+      ::close(fd_);
+    }
+  }
+
+  /// Returns the file descriptor
+  int get() const noexcept {
+    return fd_;
+  }
+  /// Returns true when a file descriptor is owned
+  explicit operator bool() const noexcept {
+    return fd_ >= 0;
+  }
+};
+#endif // __unix__
+} // namespace io
+} // namespace detail
+} // namespace cti
+
+#endif // CONTINUABLE_DETAIL_IO_HPP_INCLUDED__
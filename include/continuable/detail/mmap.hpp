@@ -0,0 +1,188 @@
+
+/*
+
+                        /~` _  _ _|_. _     _ |_ | _
+                        \_,(_)| | | || ||_|(_||_)|(/_
+
+                    https://github.com/Naios/continuable
+                                   v2.0.0
+
+  Copyright(c) 2015 - 2018 Denis Blank <denis.blank at outlook dot com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files(the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions :
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+**/
+
+#ifndef CONTINUABLE_DETAIL_MMAP_HPP_INCLUDED__
+#define CONTINUABLE_DETAIL_MMAP_HPP_INCLUDED__
+
+#include <continuable/detail/features.hpp>
+
+// Exlude this header when mmap isn't available
+#ifdef CONTINUABLE_HAS_MMAP
+
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <continuable/continuable-base.hpp>
+#include <continuable/detail/io.hpp>
+#include <continuable/detail/types.hpp>
+#include <continuable/detail/util.hpp>
+
+namespace cti {
+namespace detail {
+/// Provides the read only mapping of files
+namespace mmap {
+/// Maps a file read only into memory and unmaps it on destruction
+class mapping : public util::non_movable {
+  char const* data_ = nullptr;
+  std::size_t size_ = 0U;
+
+public:
+  /// Maps the whole file which is referred by the descriptor,
+  /// throws a `std::system_error` on failure.
+  explicit mapping(int fd) {
+    struct stat status;
+    if (::fstat(fd, &status) < 0) {
+      io::throw_system_error(errno, "fstat");
+    }
+
+    size_ = static_cast<std::size_t>(status.st_size);
+    if (!size_) {
+      // Empty files can't be mapped
+      return;
+    }
+
+    void* const data = ::mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd, 0);
+    if (data == MAP_FAILED) {
+      io::throw_system_error(errno, "mmap");
+    }
+    data_ = static_cast<char const*>(data);
+
+    // The kernel reads ahead aggressively and drops pages behind
+    // the read position early for sequential access.
+    ::madvise(data, size_, MADV_SEQUENTIAL);
+  }
+  ~mapping() {
+    if (data_) {
+      ::munmap(const_cast<char*>(data_), size_);
+    }
+  }
+
+  /// Returns the beginning of the mapping
+  char const* data() const noexcept {
+    return data_;
+  }
+  /// Returns the size of the mapping
+  std::size_t size() const noexcept {
+    return size_;
+  }
+
+  /// Asks the kernel to read the given range of the mapping ahead
+  void will_need(std::size_t offset, std::size_t size) const noexcept {
+    if (offset >= size_) {
+      return;
+    }
+    if (size > size_ - offset) {
+      size = size_ - offset;
+    }
+
+    // madvise requires an address which is aligned to the page size
+    static std::size_t const page = static_cast<std::size_t>(::getpagesize());
+    std::size_t const aligned = offset - (offset % page);
+    ::madvise(const_cast<char*>(data_) + aligned, size + (offset - aligned),
+              MADV_WILLNEED);
+  }
+};
+
+/// Opens the file for reading, throws a `std::system_error` on failure.
+inline io::file_descriptor open_read_only(char const* path) {
+  io::file_descriptor fd(::open(path, O_RDONLY | O_CLOEXEC));
+  if (!fd) {
+    io::throw_system_error(errno, "open");
+  }
+  return fd;
+}
+
+/// Drives a stage over all chunks of a reader, where the next chunk is
+/// produced only when the stage finished with the previous one.
+///
+/// Stages which finish synchronously are driven iteratively from the
+/// outermost call instead of recursively, so the stack doesn't grow with
+/// the count of chunks, no matter on which thread a stage finishes.
+template <typename Reader, typename Stage, typename Executor,
+          typename Promise>
+class pump : public std::enable_shared_from_this<
+                 pump<Reader, Stage, Executor, Promise>> {
+  Reader* reader_;
+  Stage stage_;
+  Executor executor_;
+  Promise promise_;
+  std::atomic<std::size_t> requests_{0U};
+
+public:
+  pump(Reader* reader, Stage stage, Executor executor, Promise promise)
+      : reader_(reader), stage_(std::move(stage)),
+        executor_(std::move(executor)), promise_(std::move(promise)) {
+  }
+
+  /// Produces the next chunk or continues the outer call which does so
+  void resume() {
+    if (requests_.fetch_add(1U, std::memory_order_acq_rel) != 0U) {
+      return;
+    }
+    do {
+      step();
+    } while (requests_.fetch_sub(1U, std::memory_order_acq_rel) != 1U);
+  }
+
+private:
+  void step() {
+    auto chunk = reader_->take();
+    if (chunk.empty()) {
+      std::move(promise_).set_value();
+      return;
+    }
+
+    auto self = this->shared_from_this();
+    make_continuable<decltype(chunk)>([chunk](auto&& promise) {
+      std::forward<decltype(promise)>(promise).set_value(chunk);
+    })
+        .then([self](decltype(chunk) current) { return self->stage_(current); },
+              executor_)
+        .then([self] { self->resume(); })
+        .fail([self](types::error_type error) {
+          std::move(self->promise_).set_exception(std::move(error));
+        });
+  }
+};
+} // namespace mmap
+} // namespace detail
+} // namespace cti
+
+#endif // CONTINUABLE_HAS_MMAP
+#endif // CONTINUABLE_DETAIL_MMAP_HPP_INCLUDED__
@@ -0,0 +1,185 @@
+
+/*
+
+                        /~` _  _ _|_. _     _ |_ | _
+                        \_,(_)| | | || ||_|(_||_)|(/_
+
+                    https://github.com/Naios/continuable
+                                   v2.0.0
+
+  Copyright(c) 2015 - 2018 Denis Blank <denis.blank at outlook dot com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files(the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions :
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+**/
+
+#ifndef CONTINUABLE_DETAIL_PROCESS_HPP_INCLUDED__
+#define CONTINUABLE_DETAIL_PROCESS_HPP_INCLUDED__
+
+#include <continuable/detail/features.hpp>
+
+// Exlude this header when the reactor isn't available
+#ifdef CONTINUABLE_HAS_EPOLL
+
+#include <cerrno>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <spawn.h>
+#include <sys/syscall.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <continuable/detail/io.hpp>
+#include <continuable/detail/util.hpp>
+
+extern char** environ;
+
+namespace cti {
+namespace detail {
+/// Provides the spawning of child processes
+namespace process {
+/// Owns the file actions of posix_spawn
+class file_actions : public util::non_movable {
+  posix_spawn_file_actions_t actions_;
+
+public:
+  file_actions() {
+    int const error = ::posix_spawn_file_actions_init(&actions_);
+    if (error) {
+      io::throw_system_error(error, "posix_spawn_file_actions_init");
+    }
+  }
+  ~file_actions() {
+    ::posix_spawn_file_actions_destroy(&actions_);
+  }
+
+  /// Duplicates the descriptor to the target descriptor in the child
+  void duplicate(int fd, int target) {
+    int const error =
+        ::posix_spawn_file_actions_adddup2(&actions_, fd, target);
+    if (error) {
+      io::throw_system_error(error, "posix_spawn_file_actions_adddup2");
+    }
+  }
+
+  posix_spawn_file_actions_t const* get() const noexcept {
+    return &actions_;
+  }
+};
+
+/// A pipe whose end which stays in the parent is non-blocking,
+/// both ends are closed on exec.
+struct pipe_ends {
+  io::file_descriptor read;
+  io::file_descriptor write;
+};
+
+/// Creates a pipe where the given end is non-blocking,
+/// throws a `std::system_error` on failure.
+inline pipe_ends open_pipe(bool nonblocking_read, bool nonblocking_write) {
+  int fds[2];
+  if (::pipe2(fds, O_CLOEXEC) < 0) {
+    io::throw_system_error(errno, "pipe2");
+  }
+
+  pipe_ends ends{io::file_descriptor(fds[0]), io::file_descriptor(fds[1])};
+  if (nonblocking_read) {
+    ::fcntl(fds[0], F_SETFL, ::fcntl(fds[0], F_GETFL) | O_NONBLOCK);
+  }
+  if (nonblocking_write) {
+    ::fcntl(fds[1], F_SETFL, ::fcntl(fds[1], F_GETFL) | O_NONBLOCK);
+  }
+  return ends;
+}
+
+/// Spawns the program which is searched in the `PATH` with the given
+/// arguments, throws a `std::system_error` on failure.
+inline pid_t spawn(std::vector<std::string> const& arguments,
+                   file_actions const& actions) {
+  if (arguments.empty()) {
+    io::throw_system_error(EINVAL, "posix_spawnp");
+  }
+
+  std::vector<char*> argv;
+  argv.reserve(arguments.size() + 1U);
+  for (std::string const& argument : arguments) {
+    argv.push_back(const_cast<char*>(argument.c_str()));
+  }
+  argv.push_back(nullptr);
+
+  // posix_spawn doesn't copy the address space of the parent and
+  // reports a failed exec through its result.
+  pid_t pid;
+  int const error = ::posix_spawnp(&pid, argv.front(), actions.get(), nullptr,
+                                   argv.data(), environ);
+  if (error) {
+    io::throw_system_error(error, "posix_spawnp");
+  }
+  return pid;
+}
+
+/// Reaps the child process without blocking, returns true and stores the
+/// exit status when the process exited, otherwise stores the `errno`
+/// value in the error on failure.
+inline bool try_reap(pid_t pid, int& status, int& error) noexcept {
+  int result;
+  pid_t reaped;
+  do {
+    reaped = ::waitpid(pid, &result, WNOHANG);
+  } while ((reaped < 0) && (errno == EINTR));
+
+  if (reaped < 0) {
+    error = errno;
+    return false;
+  }
+  if (reaped == 0) {
+    error = 0;
+    return false;
+  }
+
+  // Processes which were killed report the signal like a shell
+  status = WIFEXITED(result) ? WEXITSTATUS(result) : 128 + WTERMSIG(result);
+  return true;
+}
+
+/// Opens a descriptor which becomes readable when the process exited,
+/// returns an empty descriptor and stores the `errno` value on failure.
+inline io::file_descriptor open_pidfd(pid_t pid, int& error) noexcept {
+#if defined(SYS_pidfd_open)
+  long const fd = ::syscall(SYS_pidfd_open, pid, 0U);
+  if (fd < 0) {
+    error = errno;
+    return {};
+  }
+  // The descriptor of the process is closed on exec by definition
+  return io::file_descriptor(static_cast<int>(fd));
+#else
+  (void)pid;
+  error = ENOSYS;
+  return {};
+#endif
+}
+} // namespace process
+} // namespace detail
+} // namespace cti
+
+#endif // CONTINUABLE_HAS_EPOLL
+#endif // CONTINUABLE_DETAIL_PROCESS_HPP_INCLUDED__
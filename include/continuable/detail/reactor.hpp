@@ -0,0 +1,218 @@
+
+/*
+
+                        /~` _  _ _|_. _     _ |_ | _
+                        \_,(_)| | | || ||_|(_||_)|(/_
+
+                    https://github.com/Naios/continuable
+                                   v2.0.0
+
+  Copyright(c) 2015 - 2018 Denis Blank <denis.blank at outlook dot com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files(the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions :
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+**/
+
+#ifndef CONTINUABLE_DETAIL_REACTOR_HPP_INCLUDED__
+#define CONTINUABLE_DETAIL_REACTOR_HPP_INCLUDED__
+
+#include <continuable/detail/features.hpp>
+
+// Exlude this header when epoll isn't available
+#ifdef CONTINUABLE_HAS_EPOLL
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include <continuable/detail/io.hpp>
+#include <continuable/detail/util.hpp>
+
+namespace cti {
+namespace detail {
+/// Provides the readiness notification of the epoll based reactor
+namespace reactor {
+/// Owns an epoll instance together with an eventfd which is used
+/// to interrupt a blocking wait from other threads.
+///
+/// Descriptors are registered once and edge triggered for both directions,
+/// so the kernel reports every readiness change exactly once and no
+/// re-arming system call is required per operation.
+class poller : public util::non_movable {
+  io::file_descriptor epoll_;
+  io::file_descriptor wakeup_;
+
+public:
+  /// The maximal count of events which are delivered per wait
+  static constexpr int batch_size = 64;
+
+  poller()
+      : epoll_(::epoll_create1(EPOLL_CLOEXEC)),
+        wakeup_(::eventfd(0U, EFD_NONBLOCK | EFD_CLOEXEC)) {
+    if (!epoll_) {
+      io::throw_system_error(errno, "epoll_create1");
+    }
+    if (!wakeup_) {
+      io::throw_system_error(errno, "eventfd");
+    }
+
+    // The wakeup descriptor is identified by a null pointer
+    epoll_event event{};
+    event.events = EPOLLIN | EPOLLET;
+    event.data.ptr = nullptr;
+    if (::epoll_ctl(epoll_.get(), EPOLL_CTL_ADD, wakeup_.get(), &event) < 0) {
+      io::throw_system_error(errno, "epoll_ctl");
+    }
+  }
+
+  /// Registers the descriptor for edge triggered readiness in both
+  /// directions, returns zero or the `errno` value on failure.
+  int add(int fd, void* data) noexcept {
+    epoll_event event{};
+    event.events = EPOLLIN | EPOLLOUT | EPOLLRDHUP | EPOLLET;
+    event.data.ptr = data;
+    if (::epoll_ctl(epoll_.get(), EPOLL_CTL_ADD, fd, &event) < 0) {
+      return errno;
+    }
+    return 0;
+  }
+
+  /// Unregisters the descriptor
+  void remove(int fd) noexcept {
+    // A descriptor which was closed already is removed implicitly
+    epoll_event event{};
+    ::epoll_ctl(epoll_.get(), EPOLL_CTL_DEL, fd, &event);
+  }
+
+  /// Interrupts a concurrent or the next call to wait
+  void notify() noexcept {
+    std::uint64_t const value = 1U;
+    // The counter only fails to increase when it is signaled already
+    ssize_t const result = ::write(wakeup_.get(), &value, sizeof(value));
+    (void)result;
+  }
+
+  /// Waits up to the given timeout in milliseconds (-1 blocks indefinitely)
+  /// and invokes the handler with the data and the events of every
+  /// ready descriptor in the batch.
+  ///
+  /// Returns true when the poller was notified.
+  template <typename Handler>
+  bool wait(int timeout, Handler&& handler) {
+    epoll_event events[batch_size];
+    int count;
+    do {
+      count = ::epoll_wait(epoll_.get(), events, batch_size, timeout);
+    } while ((count < 0) && (errno == EINTR));
+
+    if (count < 0) {
+      io::throw_system_error(errno, "epoll_wait");
+    }
+
+    bool notified = false;
+    for (int i = 0; i < count; ++i) {
+      if (events[i].data.ptr) {
+        handler(events[i].data.ptr, events[i].events);
+      } else {
+        std::uint64_t value;
+        ssize_t const result = ::read(wakeup_.get(), &value, sizeof(value));
+        (void)result;
+        notified = true;
+      }
+    }
+    return notified;
+  }
+};
+
+/// A queue of work which is posted to the reactor from arbitrary threads
+template <typename Work>
+class work_queue : public util::non_movable {
+  std::mutex lock_;
+  std::vector<Work> queue_;
+  std::vector<Work> processing_;
+
+  /// Clears the processed work even when a work throws, the work which
+  /// wasn't invoked yet is put in front of the queue again.
+  struct process_guard {
+    work_queue* queue_;
+    std::size_t invoked_ = 0U;
+
+    ~process_guard() {
+      queue_->finish(invoked_);
+    }
+  };
+
+  void finish(std::size_t invoked) {
+    if (invoked < processing_.size()) {
+      std::lock_guard<std::mutex> lock(lock_);
+      queue_.insert(queue_.begin(),
+                    std::make_move_iterator(processing_.begin() + invoked),
+                    std::make_move_iterator(processing_.end()));
+    }
+    processing_.clear();
+  }
+
+public:
+  /// Enqueues the work and returns true when the queue was empty before,
+  /// so the reactor needs to be woken up only once per batch.
+  bool push(Work work) {
+    std::lock_guard<std::mutex> lock(lock_);
+    queue_.push_back(std::move(work));
+    return queue_.size() == 1U;
+  }
+
+  /// Returns true when no work is queued
+  bool empty() {
+    std::lock_guard<std::mutex> lock(lock_);
+    return queue_.empty();
+  }
+
+  /// Invokes all work which was queued up to now, work which is posted
+  /// while processing is deferred to the next call.
+  /// Returns the count of invoked work.
+  std::size_t process() {
+    {
+      std::lock_guard<std::mutex> lock(lock_);
+      // Both buffers keep their capacity so posting doesn't allocate
+      // once the queue has warmed up.
+      std::swap(queue_, processing_);
+    }
+
+    std::size_t const count = processing_.size();
+    process_guard guard{this};
+    for (auto& work : processing_) {
+      ++guard.invoked_;
+      work();
+    }
+    return count;
+  }
+};
+} // namespace reactor
+} // namespace detail
+} // namespace cti
+
+#endif // CONTINUABLE_HAS_EPOLL
+#endif // CONTINUABLE_DETAIL_REACTOR_HPP_INCLUDED__
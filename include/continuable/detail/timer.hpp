@@ -0,0 +1,323 @@
+
+/*
+
+                        /~` _  _ _|_. _     _ |_ | _
+                        \_,(_)| | | || ||_|(_||_)|(/_
+
+                    https://github.com/Naios/continuable
+                                   v2.0.0
+
+  Copyright(c) 2015 - 2018 Denis Blank <denis.blank at outlook dot com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files(the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions :
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+**/
+
+#ifndef CONTINUABLE_DETAIL_TIMER_HPP_INCLUDED__
+#define CONTINUABLE_DETAIL_TIMER_HPP_INCLUDED__
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <limits>
+#include <utility>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+#include <continuable/detail/io.hpp>
+#include <continuable/detail/util.hpp>
+
+namespace cti {
+namespace detail {
+/// Provides a hashed hierarchical timer wheel
+namespace timer {
+/// Refers to a scheduled timer, the generation detects handles
+/// which refer to a timer which expired or was cancelled already.
+struct handle {
+  std::uint32_t index = std::numeric_limits<std::uint32_t>::max();
+  std::uint32_t generation = 0U;
+};
+
+/// Returns the index of the lowest bit which is set in the given value
+inline unsigned lowest_bit(std::uint64_t value) noexcept {
+  assert(value && "No bit is set!");
+#if defined(_MSC_VER)
+  unsigned long index;
+  _BitScanForward64(&index, value);
+  return static_cast<unsigned>(index);
+#else
+  return static_cast<unsigned>(__builtin_ctzll(value));
+#endif
+}
+
+/// A hashed hierarchical timer wheel which stores a promise per timer.
+///
+/// The wheel consists of 4 levels of 256 buckets, where every level covers
+/// 256 times the range of the level below, so 2^32 ticks are addressable
+/// without overflowing. Timers are stored in intrusive lists,
+/// which makes inserting and cancelling a timer O(1).
+/// Timers of higher levels are cascaded into the lower levels when
+/// the wheel reaches their bucket, and every bucket of the lowest level
+/// expires as a whole. Empty buckets are skipped through a bitmap of
+/// occupied buckets per level, so advancing the wheel over a long time
+/// doesn't visit every tick.
+///
+/// The nodes are allocated from a pool which reuses expired nodes,
+/// so no allocation happens per timer once the pool has warmed up.
+template <typename Promise>
+class wheel : public util::non_movable {
+  static constexpr unsigned slot_bits = 8U;
+  static constexpr unsigned slots = 1U << slot_bits;
+  static constexpr std::uint64_t slot_mask = slots - 1U;
+  static constexpr unsigned levels = 4U;
+  static constexpr unsigned words = slots / 64U;
+
+  struct node {
+    node* prev = nullptr;
+    node* next = nullptr;
+    std::uint64_t expiry = 0U;
+    std::uint32_t index;
+    std::uint32_t generation = 0U;
+    unsigned bucket = 0U;
+    io::pending<Promise> promise;
+
+    explicit node(std::uint32_t index_) : index(index_) {
+    }
+  };
+
+  /// A deque doesn't move its elements on growth,
+  /// so the nodes are addressable through their index.
+  std::deque<node> nodes_;
+  node* free_ = nullptr;
+  node* buckets_[levels * slots] = {};
+  std::uint64_t occupied_[levels][words] = {};
+  std::uint64_t current_ = 0U;
+  std::size_t size_ = 0U;
+
+public:
+  wheel() = default;
+
+  /// Returns the current tick of the wheel
+  std::uint64_t current() const noexcept {
+    return current_;
+  }
+
+  /// Returns the count of timers which didn't expire yet
+  std::size_t size() const noexcept {
+    return size_;
+  }
+
+  /// Schedules the promise for expiry at the given tick, timers which
+  /// are due already expire on the next tick.
+  handle insert(std::uint64_t expiry, Promise promise) {
+    node* current = free_;
+    if (current) {
+      free_ = current->next;
+    } else {
+      assert(nodes_.size() < std::numeric_limits<std::uint32_t>::max());
+      nodes_.emplace_back(static_cast<std::uint32_t>(nodes_.size()));
+      current = &nodes_.back();
+    }
+
+    current->expiry = (expiry > current_) ? expiry : current_ + 1U;
+    current->promise.emplace(std::move(promise));
+    place(current);
+    ++size_;
+    return {current->index, current->generation};
+  }
+
+  /// Removes the timer which is referred by the handle and invokes
+  /// the handler with its promise, returns false when the timer
+  /// expired or was cancelled already.
+  template <typename Handler>
+  bool cancel(handle const& timer, Handler&& handler) {
+    if (timer.index >= nodes_.size()) {
+      return false;
+    }
+    node* const current = &nodes_[timer.index];
+    if ((current->generation != timer.generation) ||
+        !current->promise.has_value()) {
+      return false;
+    }
+
+    unlink(current);
+    std::forward<Handler>(handler)(release(current));
+    return true;
+  }
+
+  /// Advances the wheel up to the given tick and invokes the handler
+  /// with the promise of every expired timer, returns the count of
+  /// expired timers.
+  template <typename Handler>
+  std::size_t advance(std::uint64_t now, Handler&& handler) {
+    std::size_t expired = 0U;
+    while (current_ < now) {
+      if (!size_) {
+        current_ = now;
+        break;
+      }
+
+      std::uint64_t const target = next_event();
+      if (target > now) {
+        current_ = now;
+        break;
+      }
+
+      current_ = target;
+      if (!(current_ & slot_mask)) {
+        cascade();
+      }
+
+      // Timers which are inserted by the handler expire on later ticks,
+      // so they never end up in the bucket which is expired currently.
+      unsigned const bucket = static_cast<unsigned>(current_ & slot_mask);
+      while (node* const current = buckets_[bucket]) {
+        unlink(current);
+        ++expired;
+        handler(release(current));
+      }
+    }
+    return expired;
+  }
+
+  /// Returns the next tick at which timers could expire
+  std::uint64_t next_tick() const noexcept {
+    if (!size_) {
+      return std::numeric_limits<std::uint64_t>::max();
+    }
+    return next_event();
+  }
+
+private:
+  /// Returns the index of the next occupied bucket of the level starting
+  /// at the given index, or the count of buckets when there is none.
+  unsigned next_occupied(unsigned level, std::uint64_t from) const noexcept {
+    for (std::uint64_t word = from / 64U; word < words; ++word) {
+      std::uint64_t bits = occupied_[level][word];
+      if (word == from / 64U) {
+        bits &= ~std::uint64_t(0U) << (from % 64U);
+      }
+      if (bits) {
+        return static_cast<unsigned>(word * 64U) + lowest_bit(bits);
+      }
+    }
+    return slots;
+  }
+
+  /// Returns the next tick at which a bucket is expired or cascaded,
+  /// which skips all empty buckets and boundaries.
+  std::uint64_t next_event() const noexcept {
+    for (unsigned level = 0U; level < levels; ++level) {
+      unsigned const shift = slot_bits * level;
+      std::uint64_t const position = current_ >> shift;
+      std::uint64_t const index = position & slot_mask;
+
+      unsigned const next = next_occupied(level, index + 1U);
+      if (next < slots) {
+        return (position - index + next) << shift;
+      }
+
+      // The buckets before the current one are reached after the level
+      // wrapped around, which is a boundary of the next higher level.
+      if (next_occupied(level, 0U) < slots) {
+        return ((current_ >> (shift + slot_bits)) + 1U) << (shift + slot_bits);
+      }
+    }
+    return ((current_ >> (slot_bits * levels)) + 1U) << (slot_bits * levels);
+  }
+
+  void place(node* current) noexcept {
+    std::uint64_t const delta = current->expiry - current_;
+    unsigned level = 0U;
+    while ((level < levels - 1U) &&
+           (delta >= (std::uint64_t(1U) << (slot_bits * (level + 1U))))) {
+      ++level;
+    }
+
+    // Timers which are out of range are placed into the last bucket and
+    // placed again when they are cascaded.
+    std::uint64_t const range = std::uint64_t(1U) << (slot_bits * levels);
+    std::uint64_t const expiry =
+        (delta < range) ? current->expiry : current_ + range - 1U;
+    unsigned const slot =
+        static_cast<unsigned>((expiry >> (slot_bits * level)) & slot_mask);
+
+    current->bucket = level * slots + slot;
+    current->prev = nullptr;
+    current->next = buckets_[current->bucket];
+    if (current->next) {
+      current->next->prev = current;
+    } else {
+      occupied_[level][slot / 64U] |= std::uint64_t(1U) << (slot % 64U);
+    }
+    buckets_[current->bucket] = current;
+  }
+
+  void unlink(node* current) noexcept {
+    if (current->prev) {
+      current->prev->next = current->next;
+    } else {
+      buckets_[current->bucket] = current->next;
+      if (!current->next) {
+        unsigned const level = current->bucket / slots;
+        unsigned const slot = current->bucket % slots;
+        occupied_[level][slot / 64U] &= ~(std::uint64_t(1U) << (slot % 64U));
+      }
+    }
+    if (current->next) {
+      current->next->prev = current->prev;
+    }
+  }
+
+  /// Moves the timers of the buckets which were reached on the higher
+  /// levels into the lower levels.
+  void cascade() noexcept {
+    for (unsigned level = levels - 1U; level > 0U; --level) {
+      std::uint64_t const mask =
+          (std::uint64_t(1U) << (slot_bits * level)) - 1U;
+      if (current_ & mask) {
+        continue;
+      }
+
+      unsigned const bucket =
+          level * slots +
+          static_cast<unsigned>((current_ >> (slot_bits * level)) & slot_mask);
+      while (node* const current = buckets_[bucket]) {
+        unlink(current);
+        place(current);
+      }
+    }
+  }
+
+  Promise release(node* current) {
+    Promise promise = current->promise.take();
+    ++current->generation;
+    current->next = free_;
+    free_ = current;
+    --size_;
+    return promise;
+  }
+};
+} // namespace timer
+} // namespace detail
+} // namespace cti
+
+#endif // CONTINUABLE_DETAIL_TIMER_HPP_INCLUDED__
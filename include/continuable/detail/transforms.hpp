@@ -31,10 +31,25 @@
 #ifndef CONTINUABLE_DETAIL_TRANSFORMS_HPP_INCLUDED__
 #define CONTINUABLE_DETAIL_TRANSFORMS_HPP_INCLUDED__
 
+#include <atomic>
+#include <cstdint>
 #include <future>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#if defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#else // __linux__
+#include <condition_variable>
+#include <mutex>
+#endif // __linux__
 
 #include <continuable/continuable-api.hpp>
 #include <continuable/detail/base.hpp>
+#include <continuable/detail/expected.hpp>
 #include <continuable/detail/features.hpp>
 #include <continuable/detail/hints.hpp>
 #include <continuable/detail/types.hpp>
@@ -134,6 +149,189 @@ auto as_future(continuable_base<Data, Annotation>&& continuable) {
 
   return future;
 }
+/// A flag which blocks the waiting thread until it was notified.
+///
+/// On Linux the thread spins for a short time first and is parked through
+/// a futex afterwards, the notifying thread only issues a system call when
+/// the waiting thread was parked already.
+/// Elsewhere the flag is only read under its mutex, because the notifying
+/// thread still accesses the mutex and the condition variable after
+/// publishing the notification.
+class parking_flag : public util::non_movable {
+  enum : std::uint32_t { idle = 0U, notified = 1U, parked = 2U };
+
+  std::atomic<std::uint32_t> state_{idle};
+#if defined(__linux__)
+  /// The count of iterations the waiting thread spins before it is parked
+  static constexpr std::size_t spin_count = 1024U;
+
+  /// Tells the processor that the thread is spinning, which frees
+  /// resources for a sibling hyper-thread and saves power.
+  static void relax() noexcept {
+#if defined(__i386__) || defined(__x86_64__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+    __asm__ __volatile__("yield");
+#endif
+  }
+#else  // __linux__
+  std::mutex mutex_;
+  std::condition_variable condition_;
+#endif // __linux__
+
+public:
+  parking_flag() = default;
+
+  /// Notifies the waiting thread, the flag mustn't be accessed by the
+  /// notifying thread afterwards since the waiting thread may destroy it.
+  void notify() noexcept {
+#if defined(__linux__)
+    if (state_.exchange(notified, std::memory_order_acq_rel) == parked) {
+      ::syscall(SYS_futex, &state_, FUTEX_WAKE_PRIVATE, 1, nullptr, nullptr,
+                0);
+    }
+#else  // __linux__
+    std::lock_guard<std::mutex> lock(mutex_);
+    state_.store(notified, std::memory_order_release);
+    condition_.notify_one();
+#endif // __linux__
+  }
+
+  /// Blocks the current thread until the flag was notified
+  void wait() noexcept {
+#if defined(__linux__)
+    for (std::size_t i = 0; i < spin_count; ++i) {
+      if (state_.load(std::memory_order_acquire) == notified) {
+        return;
+      }
+      relax();
+    }
+
+    std::uint32_t expected = idle;
+    if (!state_.compare_exchange_strong(expected, parked,
+                                        std::memory_order_acq_rel)) {
+      // The flag was notified in the meantime
+      return;
+    }
+    while (state_.load(std::memory_order_acquire) != notified) {
+      ::syscall(SYS_futex, &state_, FUTEX_WAIT_PRIVATE, parked, nullptr,
+                nullptr, 0);
+    }
+#else  // __linux__
+    std::unique_lock<std::mutex> lock(mutex_);
+    condition_.wait(lock, [&] {
+      return state_.load(std::memory_order_acquire) == notified;
+    });
+#endif // __linux__
+  }
+};
+
+/// Creates the broken promise error from its error code
+template <typename Error>
+Error make_broken_promise_error_from(std::true_type /*is_constructible*/) {
+  return Error(std::make_error_code(std::future_errc::broken_promise));
+}
+/// Error types which can't be created from an error code aren't able to
+/// report the broken promise.
+template <typename Error>
+Error make_broken_promise_error_from(std::false_type /*is_constructible*/) {
+  util::trap();
+}
+
+/// Returns the error which is reported when the continuation was dropped
+/// without being resolved, like std::promise reports it to its future.
+///
+/// A custom error type is required to be constructible from a
+/// std::error_code for this, the application is trapped otherwise.
+inline types::error_type make_broken_promise_error() {
+#if defined(CONTINUABLE_WITH_CUSTOM_ERROR_TYPE) ||                             \
+    defined(CONTINUABLE_WITH_HYBRID_ERROR_TYPE)
+  return make_broken_promise_error_from<types::error_type>(
+      std::is_constructible<types::error_type, std::error_code>{});
+#elif defined(CONTINUABLE_WITH_EXCEPTIONS)
+  return std::make_exception_ptr(
+      std::future_error(std::future_errc::broken_promise));
+#else
+  return std::make_error_condition(std::future_errc::broken_promise);
+#endif
+}
+
+template <typename Hint>
+class wait_callback;
+
+/// Resolves the result of a synchronous wait and notifies the waiting thread
+///
+/// The result is resolved with a broken promise error when the callback
+/// is destroyed without being invoked, so the waiting thread isn't
+/// blocked forever.
+template <typename... Args>
+class wait_callback<hints::signature_hint_tag<Args...>> {
+  using trait_t =
+      util::detail::expected_result_trait<traits::identity<Args...>>;
+
+  typename trait_t::expected_type* result_;
+  parking_flag* flag_;
+
+public:
+  using expected_type = typename trait_t::expected_type;
+
+  explicit wait_callback(expected_type* result, parking_flag* flag)
+      : result_(result), flag_(flag) {
+  }
+  wait_callback(wait_callback&& right) noexcept
+      : result_(std::exchange(right.result_, nullptr)), flag_(right.flag_) {
+  }
+  wait_callback(wait_callback const&) = delete;
+  wait_callback& operator=(wait_callback&&) = delete;
+  wait_callback& operator=(wait_callback const&) = delete;
+  ~wait_callback() {
+    if (result_) {
+      result_->set_exception(make_broken_promise_error());
+      notify();
+    }
+  }
+
+  /// Resolves the result
+  template <typename... PassedArgs,
+            types::enable_if_result_t<PassedArgs...>* = nullptr>
+  void operator()(PassedArgs&&... args) {
+    result_->set_value(trait_t::wrap(std::forward<PassedArgs>(args)...));
+    notify();
+  }
+
+  /// Resolves the result through the error
+  void operator()(types::dispatch_error_tag, types::error_type error) {
+    result_->set_exception(std::move(error));
+    notify();
+  }
+
+private:
+  /// The waiting thread may destroy the result as soon as it was notified
+  void notify() noexcept {
+    result_ = nullptr;
+    flag_->notify();
+  }
+};
+
+/// Blocks the current thread until the continuation was resolved
+template <typename Data, typename Annotation>
+auto wait(continuable_base<Data, Annotation>&& continuable) {
+  auto materialized = base::attorney::materialize(std::move(continuable));
+
+  constexpr auto const hint =
+      hints::hint_of(traits::identify<decltype(materialized)>{});
+  using callback_t = wait_callback<std::decay_t<decltype(hint)>>;
+  (void)hint;
+
+  // The result and the flag are stored on the stack of the waiting thread
+  typename callback_t::expected_type result;
+  parking_flag flag;
+
+  std::move(materialized).next(callback_t(&result, &flag)).done();
+
+  flag.wait();
+  return result;
+}
 } // namespace transforms
 } // namespace detail
 } // namespace cti
@@ -31,27 +31,97 @@
 #ifndef CONTINUABLE_DETAIL_TYPES_HPP_INCLUDED__
 #define CONTINUABLE_DETAIL_TYPES_HPP_INCLUDED__
 
+#include <type_traits>
+
 #include <continuable/continuable-api.hpp>
 #include <continuable/detail/features.hpp>
 
-#ifndef CONTINUABLE_WITH_CUSTOM_ERROR_TYPE
 #ifndef CONTINUABLE_WITH_NO_EXCEPTIONS
 #include <exception>
+#include <system_error>
+#include <utility>
 #else // CONTINUABLE_WITH_NO_EXCEPTIONS
+#ifndef CONTINUABLE_WITH_CUSTOM_ERROR_TYPE
 #include <system_error>
-#endif // CONTINUABLE_WITH_NO_EXCEPTIONS
 #endif // CONTINUABLE_WITH_CUSTOM_ERROR_TYPE
+#endif // CONTINUABLE_WITH_NO_EXCEPTIONS
 
 namespace cti {
 namespace detail {
 /// Contains types used globally across the library
 namespace types {
+#ifndef CONTINUABLE_WITH_NO_EXCEPTIONS
+/// An error type which carries a cheap `std::error_code` inline,
+/// and only boxes exceptions when they were actually thrown.
+///
+/// Creating a `std::exception_ptr` requires to throw the exception
+/// or to call `std::make_exception_ptr`, which allocates the exception,
+/// expected errors like timeouts can be represented through an error code
+/// instead, which is passed through the chain without any allocation.
+///
+/// The error is converted implicitly to a `std::exception_ptr`,
+/// an error code is converted into a `std::system_error` on demand then.
+class hybrid_error {
+  std::error_code code_;
+  std::exception_ptr exception_;
+
+public:
+  hybrid_error() noexcept = default;
+  /// Constructs the error from an error code
+  hybrid_error(std::error_code code) noexcept : code_(code) {
+  }
+  /// Constructs the error from an exception which was thrown
+  hybrid_error(std::exception_ptr exception) noexcept
+      : exception_(std::move(exception)) {
+  }
+
+  /// Returns true when the error carries an error code
+  bool is_code() const noexcept {
+    return bool(code_);
+  }
+  /// Returns true when the error carries an exception
+  bool is_exception() const noexcept {
+    return bool(exception_);
+  }
+
+  /// Returns true when the object carries any error
+  explicit operator bool() const noexcept {
+    return is_code() || is_exception();
+  }
+
+  /// Returns the error code which is carried by the error
+  std::error_code const& get_code() const noexcept {
+    return code_;
+  }
+  /// Returns the exception which is carried by the error
+  std::exception_ptr const& get_exception() const noexcept {
+    return exception_;
+  }
+
+  /// Converts the error to a `std::exception_ptr`, an error code is boxed
+  /// into a `std::system_error` which is the only case where an
+  /// exception is created.
+  operator std::exception_ptr() const {
+    if (is_code()) {
+      return std::make_exception_ptr(std::system_error(code_));
+    }
+    return exception_;
+  }
+};
+#endif // CONTINUABLE_WITH_NO_EXCEPTIONS
+
 #ifdef CONTINUABLE_WITH_CUSTOM_ERROR_TYPE
 using error_type = CONTINUABLE_WITH_CUSTOM_ERROR_TYPE;
 #else // CONTINUABLE_WITH_CUSTOM_ERROR_TYPE
 #ifndef CONTINUABLE_WITH_NO_EXCEPTIONS
+#ifdef CONTINUABLE_WITH_HYBRID_ERROR_TYPE
+/// Represents the error type when exceptions are enabled and
+/// cheap error codes shall be passed without creating exceptions.
+using error_type = hybrid_error;
+#else  // CONTINUABLE_WITH_HYBRID_ERROR_TYPE
 /// Represents the error type when exceptions are enabled
 using error_type = std::exception_ptr;
+#endif // CONTINUABLE_WITH_HYBRID_ERROR_TYPE
 #else  // CONTINUABLE_WITH_NO_EXCEPTIONS
 /// Represents the error type when exceptions are disabled
 using error_type = std::error_condition;
@@ -63,6 +133,19 @@ struct this_thread_executor_tag {};
 /// A tag which is used to continue with an error
 struct dispatch_error_tag {};
 
+/// Is true when the given arguments are forming an error dispatch,
+/// which means the first argument is a dispatch_error_tag.
+template <typename... Args>
+struct is_error_dispatch : std::false_type {};
+template <typename First, typename... Args>
+struct is_error_dispatch<First, Args...>
+    : std::is_same<std::decay_t<First>, dispatch_error_tag> {};
+
+/// Enables a forwarding result overload only for arguments
+/// which aren't dispatching an error.
+template <typename... Args>
+using enable_if_result_t = std::enable_if_t<!is_error_dispatch<Args...>::value>;
+
 } // namespace types
 } // namespace detail
 } // namespace cti
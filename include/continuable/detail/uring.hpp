@@ -0,0 +1,339 @@
+
+/*
+
+                        /~` _  _ _|_. _     _ |_ | _
+                        \_,(_)| | | || ||_|(_||_)|(/_
+
+                    https://github.com/Naios/continuable
+                                   v2.0.0
+
+  Copyright(c) 2015 - 2018 Denis Blank <denis.blank at outlook dot com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files(the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions :
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+**/
+
+#ifndef CONTINUABLE_DETAIL_URING_HPP_INCLUDED__
+#define CONTINUABLE_DETAIL_URING_HPP_INCLUDED__
+
+#include <continuable/detail/features.hpp>
+
+// Exlude this header when io_uring isn't available
+#ifdef CONTINUABLE_HAS_IO_URING
+
+#include <atomic>
+#include <cassert>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <new>
+#include <utility>
+
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <continuable/detail/io.hpp>
+#include <continuable/detail/types.hpp>
+#include <continuable/detail/util.hpp>
+
+namespace cti {
+namespace detail {
+/// Provides an io_uring submission and completion ring
+namespace uring {
+/// A region of the ring which is shared with the kernel,
+/// the region is unmapped on destruction.
+class region : public util::non_copyable {
+  void* data_ = nullptr;
+  std::size_t size_ = 0U;
+
+public:
+  region() = default;
+  /// Maps the region at the given offset of the ring,
+  /// throws a `std::system_error` on failure.
+  region(int fd, std::size_t size, off_t offset, char const* what) {
+    void* const data = ::mmap(nullptr, size, PROT_READ | PROT_WRITE,
+                              MAP_SHARED | MAP_POPULATE, fd, offset);
+    if (data == MAP_FAILED) {
+      io::throw_system_error(errno, what);
+    }
+    data_ = data;
+    size_ = size;
+  }
+  region(region&& right) noexcept
+      : data_(std::exchange(right.data_, nullptr)),
+        size_(std::exchange(right.size_, 0U)) {
+  }
+  region& operator=(region&& right) noexcept {
+    std::swap(data_, right.data_);
+    std::swap(size_, right.size_);
+    return *this;
+  }
+  ~region() {
+    if (data_) {
+      ::munmap(data_, size_);
+    }
+  }
+
+  /// Returns the beginning of the region
+  void* get() const noexcept {
+    return data_;
+  }
+};
+
+/// Owns the submission and completion queue of an io_uring instance,
+/// which is set up through raw system calls without liburing.
+///
+/// The ring isn't thread safe and is driven by a single thread.
+class ring : public util::non_movable {
+  // Every resource is owned by its own member, so the ones which were
+  // acquired already are released when the constructor throws.
+  io::file_descriptor fd_;
+  region sq_ring_;
+  /// Is empty when the kernel maps both rings at once
+  region cq_ring_;
+  region sqe_region_;
+  io_uring_sqe* sqes_;
+
+  unsigned* sq_head_;
+  unsigned* sq_tail_;
+  unsigned sq_mask_;
+  unsigned sq_entries_;
+  unsigned* sq_array_;
+
+  unsigned* cq_head_;
+  unsigned* cq_tail_;
+  unsigned cq_mask_;
+  io_uring_cqe* cqes_;
+
+  /// The count of entries which were queued but not submitted yet
+  unsigned unsubmitted_ = 0U;
+
+  template <typename T>
+  static T* at(void* base, std::uint32_t offset) noexcept {
+    return reinterpret_cast<T*>(static_cast<char*>(base) + offset);
+  }
+
+  static unsigned load(unsigned* value) noexcept {
+    return __atomic_load_n(value, __ATOMIC_ACQUIRE);
+  }
+  static void store(unsigned* value, unsigned desired) noexcept {
+    __atomic_store_n(value, desired, __ATOMIC_RELEASE);
+  }
+
+  int enter(unsigned to_submit, unsigned min_complete, unsigned flags) {
+    for (;;) {
+      long const result =
+          ::syscall(__NR_io_uring_enter, fd_.get(), to_submit, min_complete,
+                    flags, nullptr, std::size_t(0U));
+      if (result >= 0) {
+        return static_cast<int>(result);
+      }
+      if (errno != EINTR) {
+        return -errno;
+      }
+    }
+  }
+
+public:
+  explicit ring(unsigned entries) {
+    io_uring_params params;
+    std::memset(&params, 0, sizeof(params));
+
+    long const fd = ::syscall(__NR_io_uring_setup, entries, &params);
+    if (fd < 0) {
+      io::throw_system_error(errno, "io_uring_setup");
+    }
+    fd_ = io::file_descriptor(static_cast<int>(fd));
+
+    std::size_t sq_ring_size =
+        params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    std::size_t cq_ring_size =
+        params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+
+    bool const single_mmap = params.features & IORING_FEAT_SINGLE_MMAP;
+    if (single_mmap) {
+      sq_ring_size = cq_ring_size =
+          sq_ring_size > cq_ring_size ? sq_ring_size : cq_ring_size;
+    }
+
+    sq_ring_ = region(fd_.get(), sq_ring_size, IORING_OFF_SQ_RING,
+                      "io_uring sq ring mmap");
+    if (!single_mmap) {
+      cq_ring_ = region(fd_.get(), cq_ring_size, IORING_OFF_CQ_RING,
+                        "io_uring cq ring mmap");
+    }
+    sqe_region_ = region(fd_.get(), params.sq_entries * sizeof(io_uring_sqe),
+                        IORING_OFF_SQES, "io_uring sqes mmap");
+    sqes_ = static_cast<io_uring_sqe*>(sqe_region_.get());
+
+    void* const sq_ring = sq_ring_.get();
+    void* const cq_ring = single_mmap ? sq_ring : cq_ring_.get();
+
+    sq_head_ = at<unsigned>(sq_ring, params.sq_off.head);
+    sq_tail_ = at<unsigned>(sq_ring, params.sq_off.tail);
+    sq_mask_ = *at<unsigned>(sq_ring, params.sq_off.ring_mask);
+    sq_entries_ = *at<unsigned>(sq_ring, params.sq_off.ring_entries);
+    sq_array_ = at<unsigned>(sq_ring, params.sq_off.array);
+
+    cq_head_ = at<unsigned>(cq_ring, params.cq_off.head);
+    cq_tail_ = at<unsigned>(cq_ring, params.cq_off.tail);
+    cq_mask_ = *at<unsigned>(cq_ring, params.cq_off.ring_mask);
+    cqes_ = at<io_uring_cqe>(cq_ring, params.cq_off.cqes);
+  }
+
+  /// Returns a cleared submission queue entry, the queue is submitted
+  /// to the kernel first when it is full. Returns a nullptr when the
+  /// kernel didn't accept further entries.
+  io_uring_sqe* acquire() {
+    unsigned const tail = *sq_tail_;
+    if (tail - load(sq_head_) >= sq_entries_) {
+      submit();
+      if (tail - load(sq_head_) >= sq_entries_) {
+        return nullptr;
+      }
+    }
+
+    unsigned const index = tail & sq_mask_;
+    io_uring_sqe* const sqe = &sqes_[index];
+    std::memset(sqe, 0, sizeof(*sqe));
+    sq_array_[index] = index;
+    return sqe;
+  }
+
+  /// Queues the entry which was acquired last, the entries are
+  /// submitted in batches through submit() or wait().
+  void push() noexcept {
+    store(sq_tail_, *sq_tail_ + 1U);
+    ++unsubmitted_;
+  }
+
+  /// Submits all queued entries to the kernel,
+  /// returns the count of submitted entries or a negative error.
+  int submit() {
+    if (!unsubmitted_) {
+      return 0;
+    }
+    int const submitted = enter(unsubmitted_, 0U, 0U);
+    if (submitted > 0) {
+      unsubmitted_ -= static_cast<unsigned>(submitted);
+    }
+    return submitted;
+  }
+
+  /// Submits all queued entries and waits until at least one completion
+  /// is available, returns a negative error on failure.
+  int wait() {
+    int const submitted = enter(unsubmitted_, 1U, IORING_ENTER_GETEVENTS);
+    if (submitted > 0) {
+      unsubmitted_ -= static_cast<unsigned>(submitted);
+    }
+    return submitted;
+  }
+
+  /// Invokes the given handler with the user data and the result of every
+  /// available completion. The completion is released before the handler
+  /// is invoked, so the handler may submit and reap further entries.
+  template <typename Handler>
+  std::size_t reap(Handler&& handler) {
+    std::size_t reaped = 0U;
+    for (;;) {
+      unsigned const head = *cq_head_;
+      if (head == load(cq_tail_)) {
+        return reaped;
+      }
+
+      io_uring_cqe const& cqe = cqes_[head & cq_mask_];
+      std::uint64_t const user_data = cqe.user_data;
+      std::int32_t const result = cqe.res;
+      store(cq_head_, head + 1U);
+
+      handler(user_data, result);
+      ++reaped;
+    }
+  }
+};
+
+/// Stores the promises of the operations which are in flight in slots
+/// which are reused, so no allocation happens per operation
+/// after the pool was warmed up.
+template <typename Promise>
+class operation_pool : public util::non_movable {
+  struct operation {
+    std::aligned_storage_t<sizeof(Promise), alignof(Promise)> storage;
+    operation* next_free = nullptr;
+
+    Promise& promise() noexcept {
+      return *reinterpret_cast<Promise*>(&storage);
+    }
+  };
+
+  /// A deque doesn't move its elements on growth, so the slots
+  /// are addressable through the user data of the ring.
+  std::deque<operation> operations_;
+  operation* free_ = nullptr;
+  std::size_t in_flight_ = 0U;
+
+public:
+  operation_pool() = default;
+  ~operation_pool() {
+    assert(!in_flight_ && "Destroyed the ring while operations are pending!");
+  }
+
+  /// Stores the promise and returns the user data which refers to it
+  std::uint64_t acquire(Promise promise) {
+    operation* slot = free_;
+    if (slot) {
+      free_ = slot->next_free;
+    } else {
+      operations_.emplace_back();
+      slot = &operations_.back();
+    }
+
+    new (&slot->storage) Promise(std::move(promise));
+    ++in_flight_;
+    return reinterpret_cast<std::uint64_t>(slot);
+  }
+
+  /// Moves the promise out of the slot which is referred by the user data
+  /// and releases the slot.
+  Promise release(std::uint64_t user_data) {
+    operation* const slot = reinterpret_cast<operation*>(user_data);
+    Promise promise = std::move(slot->promise());
+    slot->promise().~Promise();
+
+    slot->next_free = free_;
+    free_ = slot;
+    --in_flight_;
+    return promise;
+  }
+
+  /// Returns the count of operations which are in flight
+  std::size_t in_flight() const noexcept {
+    return in_flight_;
+  }
+};
+} // namespace uring
+} // namespace detail
+} // namespace cti
+
+#endif // CONTINUABLE_HAS_IO_URING
+#endif // CONTINUABLE_DETAIL_URING_HPP_INCLUDED__
@@ -72,6 +72,31 @@ struct is_invokable_impl<
 template <typename T, typename Args>
 using is_invokable = typename detail::is_invokable_impl<T, Args>::type;
 
+namespace detail {
+template <typename T, typename Args, typename = traits::void_t<>>
+struct is_nothrow_invokable_impl : std::common_type<std::false_type> {};
+
+template <typename T, typename... Args>
+struct is_nothrow_invokable_impl<
+    T, std::tuple<Args...>,
+    traits::void_t<decltype(std::declval<T>()(std::declval<Args>()...))>>
+    : std::common_type<std::integral_constant<
+          bool, noexcept(std::declval<T>()(std::declval<Args>()...))>> {};
+} // namespace detail
+
+/// Deduces to a std::true_type if the given type is callable with the arguments
+/// inside the given tuple and the invocation is declared as `noexcept`.
+///
+/// Objects which are only partially invokable with the arguments deduce
+/// to a std::false_type.
+///
+/// ```cpp
+/// util::is_nothrow_invokable<object, std::tuple<Args...>>
+/// ```
+template <typename T, typename Args>
+using is_nothrow_invokable =
+    typename detail::is_nothrow_invokable_impl<T, Args>::type;
+
 namespace detail {
 /// Forwards every element in the tuple except the last one
 template <typename T>
@@ -159,6 +184,21 @@ template <typename T, typename... Args>
       is_invokable, std::forward<T>(callable), std::forward<Args>(args)...);
 }
 
+/// Forwards the given value as it is when it is an rvalue whose type matches
+/// the type T, otherwise the value is converted to T.
+///
+/// This is used for passing values by reference through a chain of callbacks,
+/// while still converting them to the types of the signature when needed.
+/// Lvalues are copied into a prvalue, since the callbacks of a by value
+/// signature are allowed to accept their arguments as rvalue reference.
+template <typename T, typename V>
+constexpr auto forward_as(V&& value)
+    -> std::conditional_t<std::is_same<std::decay_t<V>, T>::value &&
+                              !std::is_lvalue_reference<V>::value,
+                          V&&, T> {
+  return std::forward<V>(value);
+}
+
 // Class for making child classes non copyable
 struct non_copyable {
   constexpr non_copyable() = default;
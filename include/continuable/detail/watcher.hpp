@@ -0,0 +1,116 @@
+
+/*
+
+                        /~` _  _ _|_. _     _ |_ | _
+                        \_,(_)| | | || ||_|(_||_)|(/_
+
+                    https://github.com/Naios/continuable
+                                   v2.0.0
+
+  Copyright(c) 2015 - 2018 Denis Blank <denis.blank at outlook dot com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files(the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions :
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+**/
+
+#ifndef CONTINUABLE_DETAIL_WATCHER_HPP_INCLUDED__
+#define CONTINUABLE_DETAIL_WATCHER_HPP_INCLUDED__
+
+#include <continuable/detail/features.hpp>
+
+// Exlude this header when epoll isn't available
+#ifdef CONTINUABLE_HAS_EPOLL
+
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <cstring>
+
+#include <sys/inotify.h>
+#include <sys/timerfd.h>
+
+#include <continuable/detail/io.hpp>
+
+namespace cti {
+namespace detail {
+/// Provides the inotify and timer descriptors of the file watcher
+namespace watcher {
+/// The size of the buffer which receives the events, which is large
+/// enough for many events with names of the maximal length.
+constexpr std::size_t buffer_size = 64U * 1024U;
+
+/// Opens a non-blocking inotify instance,
+/// throws a `std::system_error` on failure.
+inline io::file_descriptor open_inotify() {
+  io::file_descriptor fd(::inotify_init1(IN_NONBLOCK | IN_CLOEXEC));
+  if (!fd) {
+    io::throw_system_error(errno, "inotify_init1");
+  }
+  return fd;
+}
+
+/// Opens a non-blocking monotonic timer,
+/// throws a `std::system_error` on failure.
+inline io::file_descriptor open_timer() {
+  io::file_descriptor fd(
+      ::timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC));
+  if (!fd) {
+    io::throw_system_error(errno, "timerfd_create");
+  }
+  return fd;
+}
+
+/// Arms the timer to expire once after the given non-zero duration,
+/// returns the `errno` value on failure.
+inline int arm(int fd, std::chrono::nanoseconds duration) noexcept {
+  using std::chrono::duration_cast;
+  using std::chrono::seconds;
+
+  itimerspec expiration{};
+  seconds const whole = duration_cast<seconds>(duration);
+  expiration.it_value.tv_sec = static_cast<time_t>(whole.count());
+  expiration.it_value.tv_nsec = static_cast<long>((duration - whole).count());
+  if (::timerfd_settime(fd, 0, &expiration, nullptr) != 0) {
+    return errno;
+  }
+  return 0;
+}
+
+/// Invokes the visitor with the watch descriptor, the mask and the name
+/// of every event in the buffer, the name is empty for events which
+/// refer to the watched path itself.
+template <typename Visitor>
+void for_each_event(char const* buffer, std::size_t size, Visitor&& visitor) {
+  std::size_t offset = 0U;
+  while (offset + sizeof(inotify_event) <= size) {
+    // The events are copied out since the buffer isn't aligned for them
+    inotify_event event;
+    std::memcpy(&event, buffer + offset, sizeof(inotify_event));
+    char const* const name = buffer + offset + sizeof(inotify_event);
+    std::size_t const length = event.len ? ::strnlen(name, event.len) : 0U;
+
+    visitor(event.wd, event.mask, name, length);
+    offset += sizeof(inotify_event) + event.len;
+  }
+}
+} // namespace watcher
+} // namespace detail
+} // namespace cti
+
+#endif // CONTINUABLE_HAS_EPOLL
+#endif // CONTINUABLE_DETAIL_WATCHER_HPP_INCLUDED__
@@ -0,0 +1,228 @@
+
+/*
+
+                        /~` _  _ _|_. _     _ |_ | _
+                        \_,(_)| | | || ||_|(_||_)|(/_
+
+                    https://github.com/Naios/continuable
+                                   v2.0.0
+
+  Copyright(c) 2015 - 2018 Denis Blank <denis.blank at outlook dot com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files(the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions :
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+**/
+
+#ifndef CONTINUABLE_EXTERNAL_ASIO_HPP_INCLUDED__
+#define CONTINUABLE_EXTERNAL_ASIO_HPP_INCLUDED__
+
+#include <system_error>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#if defined(CONTINUABLE_WITH_BOOST_ASIO)
+#include <boost/asio/async_result.hpp>
+#include <boost/system/error_code.hpp>
+#else
+#include <asio/async_result.hpp>
+#include <asio/error_code.hpp>
+#endif
+
+#include <continuable/continuable-base.hpp>
+#include <continuable/continuable-types.hpp>
+#include <continuable/detail/io.hpp>
+#include <continuable/detail/traits.hpp>
+
+#if defined(CONTINUABLE_WITH_BOOST_ASIO)
+#define CONTINUABLE_DETAIL_ASIO_NAMESPACE_BEGIN                                \
+  namespace boost {                                                            \
+  namespace asio {
+#define CONTINUABLE_DETAIL_ASIO_NAMESPACE_END                                  \
+  }                                                                            \
+  }
+#if !defined(BOOST_ASIO_HAS_RETURN_TYPE_DEDUCTION)
+#define CONTINUABLE_DETAIL_ASIO_HAS_EXPLICIT_RETURN_TYPE
+#endif
+#else
+#define CONTINUABLE_DETAIL_ASIO_NAMESPACE_BEGIN namespace asio {
+#define CONTINUABLE_DETAIL_ASIO_NAMESPACE_END }
+#if !defined(ASIO_HAS_RETURN_TYPE_DEDUCTION)
+#define CONTINUABLE_DETAIL_ASIO_HAS_EXPLICIT_RETURN_TYPE
+#endif
+#endif
+
+namespace cti {
+/// The type of the cti::use_continuable completion token
+///
+/// \since version 2.0.0
+struct use_continuable_t {};
+
+/// A completion token for asio which makes any asynchronous initiating
+/// function return a continuable, instead of taking a callback:
+/// ```cpp
+/// socket.async_read_some(asio::buffer(buffer), cti::use_continuable)
+///   .then([](std::size_t bytes_transferred) {
+///     // ...
+///   })
+///   .fail([](cti::error_type error) {
+///     // ...
+///   });
+/// ```
+///
+/// The leading error code of the completion signature is mapped to the
+/// error handler, the remaining arguments resolve the continuable.
+/// The operation is started lazily when the continuable is invoked,
+/// and the completion handler is constructed in place from the promise,
+/// so no additional state is allocated per operation.
+///
+/// Standalone asio is used by default, Boost.Asio is used when
+/// `CONTINUABLE_WITH_BOOST_ASIO` is defined.
+///
+/// \attention The token relies on the `initiate` protocol of `async_result`
+///            which is available since asio 1.13.0 (Boost 1.70).
+///
+/// \since version 2.0.0
+constexpr use_continuable_t use_continuable{};
+
+namespace detail {
+/// Provides the integration of the asio completion token
+namespace asio {
+#if defined(CONTINUABLE_WITH_BOOST_ASIO)
+using error_code_t = ::boost::system::error_code;
+#else
+using error_code_t = ::asio::error_code;
+#endif
+
+/// A completion handler which resolves the promise with the
+/// arguments of the completion
+template <typename Promise>
+struct value_handler {
+  Promise promise;
+
+  template <typename... Args>
+  void operator()(Args&&... args) {
+    std::move(promise).set_value(std::forward<Args>(args)...);
+  }
+};
+
+/// A completion handler which rejects the promise when the leading
+/// error code carries an error, and resolves it with the remaining
+/// arguments otherwise.
+template <typename Promise>
+struct error_code_handler {
+  Promise promise;
+
+  template <typename... Args>
+  void operator()(error_code_t const& error, Args&&... args) {
+    if (error) {
+      // A Boost error code converts to the equivalent std::error_code
+      std::move(promise).set_exception(
+          io::make_system_error(static_cast<std::error_code>(error)));
+    } else {
+      std::move(promise).set_value(std::forward<Args>(args)...);
+    }
+  }
+};
+
+/// Maps the arguments of a completion signature to the handler
+/// and the arguments of the continuable.
+template <typename... Args>
+struct completion_of {
+  template <typename Promise>
+  using handler_t = value_handler<Promise>;
+  using hint_t = traits::identity<Args...>;
+};
+template <typename... Args>
+struct completion_of<error_code_t, Args...> {
+  template <typename Promise>
+  using handler_t = error_code_handler<Promise>;
+  using hint_t = traits::identity<Args...>;
+};
+
+template <typename Signature>
+struct completion;
+template <typename Result, typename... Args>
+struct completion<Result(Args...)>
+    : completion_of<std::decay_t<Args>...> {};
+
+template <typename... Args, typename Continuation>
+auto create(traits::identity<Args...>, Continuation&& continuation) {
+  return make_continuable<Args...>(std::forward<Continuation>(continuation));
+}
+template <typename Continuation>
+auto create(traits::identity<>, Continuation&& continuation) {
+  return make_continuable<void>(std::forward<Continuation>(continuation));
+}
+
+/// Returns a continuable which starts the operation through the
+/// initiation with a handler which is constructed from the promise.
+template <typename Signature, typename Initiation, typename... Args>
+auto initiate(Initiation initiation, Args... args) {
+  using completion_t = completion<Signature>;
+
+  return create(
+      typename completion_t::hint_t{},
+      [initiation = std::move(initiation),
+       args = std::make_tuple(std::move(args)...)](auto&& promise) mutable {
+        using promise_t = std::decay_t<decltype(promise)>;
+        using handler_t =
+            typename completion_t::template handler_t<promise_t>;
+
+        traits::unpack(std::move(args), [&](auto&&... unpacked) {
+          std::move(initiation)(
+              handler_t{std::forward<decltype(promise)>(promise)},
+              std::forward<decltype(unpacked)>(unpacked)...);
+        });
+      });
+}
+
+#if defined(CONTINUABLE_DETAIL_ASIO_HAS_EXPLICIT_RETURN_TYPE)
+template <typename... Args>
+auto erased_continuable_of(traits::identity<Args...>)
+    -> cti::continuable<Args...>;
+#endif
+} // namespace asio
+} // namespace detail
+} // namespace cti
+
+CONTINUABLE_DETAIL_ASIO_NAMESPACE_BEGIN
+template <typename Signature>
+class async_result<cti::use_continuable_t, Signature> {
+public:
+#if defined(CONTINUABLE_DETAIL_ASIO_HAS_EXPLICIT_RETURN_TYPE)
+  /// The continuable is type erased when asio can't deduce
+  /// the return type of the initiating function.
+  using return_type = decltype(cti::detail::asio::erased_continuable_of(
+      typename cti::detail::asio::completion<Signature>::hint_t{}));
+#endif
+
+  template <typename Initiation, typename... Args>
+  static auto initiate(Initiation&& initiation, cti::use_continuable_t,
+                       Args&&... args) {
+    return cti::detail::asio::initiate<Signature>(
+        std::forward<Initiation>(initiation), std::forward<Args>(args)...);
+  }
+};
+CONTINUABLE_DETAIL_ASIO_NAMESPACE_END
+
+#undef CONTINUABLE_DETAIL_ASIO_HAS_EXPLICIT_RETURN_TYPE
+#undef CONTINUABLE_DETAIL_ASIO_NAMESPACE_BEGIN
+#undef CONTINUABLE_DETAIL_ASIO_NAMESPACE_END
+
+#endif // CONTINUABLE_EXTERNAL_ASIO_HPP_INCLUDED__
@@ -0,0 +1,95 @@
+
+/*
+  Copyright(c) 2015 - 2018 Denis Blank <denis.blank at outlook dot com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files(the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions :
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+**/
+
+/// This benchmark measures a synchronous chain of
+/// `CONTINUABLE_BENCHMARK_STAGES` stages, which are `noexcept` unless
+/// `CONTINUABLE_BENCHMARK_THROWING` is set.
+/// Every stage calls into another translation unit, such that the compiler
+/// can't prove on its own that the stages don't throw.
+
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <type_traits>
+#include <continuable/continuable.hpp>
+
+#ifndef CONTINUABLE_BENCHMARK_STAGES
+#define CONTINUABLE_BENCHMARK_STAGES 20
+#endif
+
+#if defined(CONTINUABLE_BENCHMARK_THROWING)
+#define CONTINUABLE_BENCHMARK_NOEXCEPT false
+#else
+#define CONTINUABLE_BENCHMARK_NOEXCEPT true
+#endif
+
+int opaque_increment(int value);
+
+namespace {
+struct stage {
+  int operator()(int value) const noexcept(CONTINUABLE_BENCHMARK_NOEXCEPT) {
+    return opaque_increment(value);
+  }
+};
+
+template <typename Continuable>
+auto append_stages(Continuable&& continuable,
+                   std::integral_constant<std::size_t, 0>) {
+  return std::forward<Continuable>(continuable);
+}
+template <typename Continuable, std::size_t Left>
+auto append_stages(Continuable&& continuable,
+                   std::integral_constant<std::size_t, Left>) {
+  return append_stages(std::forward<Continuable>(continuable).then(stage{}),
+                       std::integral_constant<std::size_t, Left - 1>{});
+}
+
+int run_chain(int start) {
+  int result = 0;
+  append_stages(cti::make_continuable<int>([start](auto&& promise) {
+                  promise.set_value(start);
+                }),
+                std::integral_constant<std::size_t,
+                                       CONTINUABLE_BENCHMARK_STAGES>{})
+      .then([&](int value) noexcept { result = value; });
+  return result;
+}
+} // namespace
+
+int main(int, char**) {
+  int const iterations = 1000000;
+  int checksum = 0;
+
+  auto const begin = std::chrono::steady_clock::now();
+  for (int i = 0; i < iterations; ++i) {
+    checksum += run_chain(i);
+  }
+  auto const end = std::chrono::steady_clock::now();
+
+  std::chrono::duration<double, std::nano> const elapsed = end - begin;
+  std::printf("%d stages (%s): %.1f ns per chain (checksum %d)\n",
+              CONTINUABLE_BENCHMARK_STAGES,
+              CONTINUABLE_BENCHMARK_NOEXCEPT ? "noexcept" : "throwing",
+              elapsed.count() / iterations, checksum);
+  return 0;
+}
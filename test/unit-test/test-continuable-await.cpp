@@ -21,18 +21,29 @@
   SOFTWARE.
 **/
 
-#ifdef CONTINUABLE_HAS_EXPERIMENTAL_COROUTINE
+#include <continuable/detail/features.hpp>
+
+#ifdef CONTINUABLE_HAS_COROUTINE
 
 #ifndef CONTINUABLE_WITH_NO_EXCEPTIONS
 #include <exception>
 #endif // CONTINUABLE_WITH_NO_EXCEPTIONS
 
+#include <functional>
+#include <future>
+#include <memory>
+#include <thread>
 #include <tuple>
+#include <vector>
 
 #include "test-continuable.hpp"
 
+#if defined(CONTINUABLE_HAS_EXPERIMENTAL_COROUTINE)
 namespace std {
 namespace experimental {
+#else  // CONTINUABLE_HAS_EXPERIMENTAL_COROUTINE
+namespace std {
+#endif // CONTINUABLE_HAS_EXPERIMENTAL_COROUTINE
 template <class... T>
 struct coroutine_traits<void, T...> {
   struct promise_type {
@@ -61,8 +72,12 @@ struct coroutine_traits<void, T...> {
     }
   };
 };
+#if defined(CONTINUABLE_HAS_EXPERIMENTAL_COROUTINE)
 } // namespace experimental
 } // namespace std
+#else  // CONTINUABLE_HAS_EXPERIMENTAL_COROUTINE
+} // namespace std
+#endif // CONTINUABLE_HAS_EXPERIMENTAL_COROUTINE
 
 /// Resolves the given promise asynchonously
 template <typename S, typename T>
@@ -145,17 +160,264 @@ TYPED_TEST(single_dimension_tests, are_awaitable_with_exceptions) {
       })));
 }
 
-// TODO Implement this later
-//
-//  static cti::continuable<int> async_await() {
-//   co_await cti::make_continuable<void>([](auto&& promise) {
-//     // ...
-//     promise.set_value();
-//   });
-//
-//   co_return 1;
-// }
+static cti::continuable<int> async_await_throw() {
+  co_await cti::make_continuable<void>([](auto&& promise) {
+    // ...
+    promise.set_value();
+  });
+  throw await_exception{};
+}
+
+static cti::continuable<int> async_await_all_throw() {
+  auto const& supply = [] {
+    return cti::make_continuable<int>(
+        [](auto&& promise) { promise.set_value(1); });
+  };
+
+  auto result = co_await (supply() && supply().then([](int) -> int {
+                            throw await_exception{};
+                          }));
+  co_return std::get<0>(result);
+}
+
+TEST(await_continuable_returning_tests, are_rejected_through_exceptions) {
+  ASSERT_ASYNC_EXCEPTION_RESULT(async_await_throw(), await_exception{});
+  ASSERT_ASYNC_EXCEPTION_RESULT(async_await_all_throw(), await_exception{});
+}
+
+static cti::continuable<int, int>
+async_await_all_failing(std::unique_ptr<cti::promise<int>>& pending) {
+  auto async = cti::make_continuable<int>([&](auto&& promise) {
+    pending = std::make_unique<cti::promise<int>>(std::move(promise));
+  });
+
+  co_return co_await (std::move(async) &&
+                      cti::make_continuable<int>([](auto&& promise) {
+                        promise.set_exception(supply_test_exception());
+                      }));
+}
+
+TEST(await_continuable_returning_tests, are_rejected_on_the_first_error) {
+  std::unique_ptr<cti::promise<int>> pending;
+  bool rejected = false;
+  async_await_all_failing(pending).fail([&](cti::error_type) {
+    rejected = true;
+  });
+
+  // The coroutine is resumed without waiting for the pending continuation,
+  // which is resolved after the coroutine frame was destroyed.
+  ASSERT_TRUE(rejected);
+  ASSERT_TRUE(pending);
+  std::move(*pending).set_value(1);
+}
 
 #endif // CONTINUABLE_WITH_NO_EXCEPTIONS
 
-#endif // CONTINUABLE_HAS_EXPERIMENTAL_COROUTINE
+static cti::continuable<> async_await_void() {
+  co_await cti::make_continuable<void>([](auto&& promise) {
+    // ...
+    promise.set_value();
+  });
+  co_return;
+}
+
+static cti::continuable<int> async_await() {
+  co_await cti::make_continuable<void>([](auto&& promise) {
+    // ...
+    promise.set_value();
+  });
+
+  co_return 1;
+}
+
+static cti::continuable<int, int> async_await_multiple() {
+  int a = co_await async_await();
+  int b = co_await async_await();
+  co_return std::make_tuple(a, b + 1);
+}
+
+TEST(await_continuable_returning_tests, are_resolved_through_co_return) {
+  ASSERT_ASYNC_COMPLETION(async_await_void());
+  ASSERT_ASYNC_RESULT(async_await(), 1);
+  ASSERT_ASYNC_RESULT(async_await_multiple(), 1, 2);
+}
+
+TEST(await_continuable_returning_tests, are_started_lazily) {
+  bool started = false;
+  auto coroutine = [&]() -> cti::continuable<int> {
+    started = true;
+    co_return 1;
+  };
+
+  auto continuable = coroutine();
+  ASSERT_FALSE(started);
+  ASSERT_ASYNC_RESULT(std::move(continuable), 1);
+  ASSERT_TRUE(started);
+}
+
+static cti::continuable<int> async_await_chain(int depth) {
+  if (depth == 0) {
+    co_return 0;
+  }
+  int result = co_await async_await_chain(depth - 1);
+  co_return result + 1;
+}
+
+static cti::continuable<int> async_await_ready(int count) {
+  int result = 0;
+  for (int i = 0; i < count; ++i) {
+    result += co_await cti::make_continuable<int>([](auto&& promise) {
+      // Resolve the continuable synchronously
+      promise.set_value(1);
+    });
+  }
+  co_return result;
+}
+
+TEST(await_continuable_returning_tests, are_continued_synchronously) {
+  // Synchronously resolved continuables don't resume the coroutine
+  // recursively, otherwise this would exhaust the stack.
+  ASSERT_ASYNC_RESULT(async_await_ready(100000), 100000);
+}
+
+static cti::continuable<int, int, int> async_await_all() {
+  auto const& supply = [](auto... args) {
+    return cti::make_continuable<void>([](auto&& promise) {
+             promise.set_value();
+           })
+        .then([=] { return std::make_tuple(args...); });
+  };
+
+  co_await (supply() && supply());
+
+  int a = co_await (supply(1) && supply());
+
+  std::tuple<int, int> b = co_await (supply(2) && supply(3));
+
+  // The results of nested compositions are flattened
+  std::tuple<int, int, int> c = co_await (supply(4) && supply() &&
+                                          (supply(5) && supply(6)));
+
+  EXPECT_EQ(a, 1);
+  EXPECT_EQ(b, std::make_tuple(2, 3));
+  EXPECT_EQ(c, std::make_tuple(4, 5, 6));
+
+  co_return std::make_tuple(a, std::get<1>(b), std::get<2>(c));
+}
+
+static cti::continuable<int, int>
+async_await_all_async(std::unique_ptr<cti::promise<int>>& pending) {
+  auto async = cti::make_continuable<int>([&](auto&& promise) {
+    pending = std::make_unique<cti::promise<int>>(std::move(promise));
+  });
+
+  co_return co_await (cti::make_continuable<int>([](auto&& promise) {
+                        promise.set_value(1);
+                      }) &&
+                      std::move(async));
+}
+
+TEST(await_continuable_returning_tests, await_all_compositions) {
+  ASSERT_ASYNC_RESULT(async_await_all(), 1, 3, 6);
+
+  std::unique_ptr<cti::promise<int>> pending;
+  bool resolved = false;
+  async_await_all_async(pending).then([&](int a, int b) {
+    EXPECT_EQ(a, 1);
+    EXPECT_EQ(b, 2);
+    resolved = true;
+  });
+
+  ASSERT_FALSE(resolved);
+  ASSERT_TRUE(pending);
+  std::move(*pending).set_value(2);
+  ASSERT_TRUE(resolved);
+}
+
+static cti::continuable<std::thread::id>
+async_await_executor(std::vector<std::function<void()>>& queue) {
+  co_await cti::on([&](auto&& work) {
+    queue.push_back(std::forward<decltype(work)>(work));
+  });
+  co_return std::this_thread::get_id();
+}
+
+TEST(await_continuable_returning_tests, are_resumed_on_executors) {
+  std::vector<std::function<void()>> queue;
+  bool resolved = false;
+  async_await_executor(queue).then([&](std::thread::id) {
+    resolved = true;
+  });
+
+  ASSERT_FALSE(resolved);
+  ASSERT_EQ(queue.size(), 1U);
+  queue.front()();
+  ASSERT_TRUE(resolved);
+}
+
+TEST(await_continuable_returning_tests, are_resumed_on_other_threads) {
+  std::promise<std::thread::id> resumed;
+  auto coroutine = []() -> cti::continuable<std::thread::id> {
+    co_await cti::on([](auto&& work) {
+      std::thread(std::forward<decltype(work)>(work)).detach();
+    });
+    co_return std::this_thread::get_id();
+  };
+
+  coroutine().then([&](std::thread::id id) { resumed.set_value(id); });
+  EXPECT_NE(resumed.get_future().get(), std::this_thread::get_id());
+}
+
+static cti::continuable<int> async_await_expected() {
+  auto value = co_await cti::as_expected(
+      cti::make_continuable<int>([](auto&& promise) {
+        // ...
+        promise.set_value(1);
+      }));
+  EXPECT_TRUE(value.is_value());
+
+  auto error =
+      co_await cti::as_expected(cti::make_continuable<int>([](auto&& promise) {
+        // ...
+        promise.set_exception(supply_test_exception());
+      }));
+  EXPECT_TRUE(error.is_exception());
+
+  auto composed = co_await cti::as_expected(
+      cti::make_continuable<int>(
+          [](auto&& promise) { promise.set_value(2); }) &&
+      cti::make_continuable<void>([](auto&& promise) {
+        promise.set_exception(supply_test_exception());
+      }));
+  EXPECT_TRUE(composed.is_exception());
+
+  co_return value.get_value();
+}
+
+TEST(await_continuable_returning_tests, are_awaitable_as_expected) {
+  ASSERT_ASYNC_RESULT(async_await_expected(), 1);
+}
+
+TEST(await_continuable_returning_tests, reuse_pooled_frames) {
+  using cti::detail::awaiting::frame_pool;
+
+  void* frame = frame_pool::allocate(100);
+  frame_pool::deallocate(frame, 100);
+  // Frames of the same size class are reused
+  void* reused = frame_pool::allocate(120);
+  EXPECT_EQ(frame, reused);
+  frame_pool::deallocate(reused, 120);
+
+  // Frames larger than the largest size class aren't pooled
+  void* large = frame_pool::allocate(64 * 1024);
+  frame_pool::deallocate(large, 64 * 1024);
+
+  ASSERT_ASYNC_RESULT(async_await(), 1);
+  ASSERT_ASYNC_RESULT(async_await(), 1);
+}
+
+TEST(await_continuable_returning_tests, are_chainable_deeply) {
+  ASSERT_ASYNC_RESULT(async_await_chain(1000), 1000);
+}
+
+#endif // CONTINUABLE_HAS_COROUTINE
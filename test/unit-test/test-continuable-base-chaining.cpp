@@ -60,3 +60,29 @@ TYPED_TEST(single_dimension_tests, are_continuing_chainable) {
 
   ASSERT_ASYNC_TYPES(std::move(chain), tag1);
 }
+
+TYPED_TEST(single_dimension_tests, are_noexcept_chainable) {
+  auto chain = this->supply()
+                   .then([]() noexcept { return tag1{}; })
+                   .then([](tag1) noexcept { return std::make_tuple(0xFD); })
+                   .then([](int value) noexcept { return value; });
+
+  EXPECT_ASYNC_RESULT(std::move(chain), 0xFD);
+}
+
+TEST(noexcept_detection_tests, are_noexcept_callbacks_detected) {
+  using cti::detail::util::is_nothrow_invokable;
+
+  auto nothrow = [](int) noexcept {};
+  auto throwing = [](int) {};
+
+  static_assert(
+      is_nothrow_invokable<decltype(nothrow), std::tuple<int>>::value,
+      "Expected the callback to be detected as noexcept!");
+  static_assert(
+      !is_nothrow_invokable<decltype(throwing), std::tuple<int>>::value,
+      "Expected the callback to be detected as throwing!");
+  static_assert(!is_nothrow_invokable<decltype(nothrow),
+                                      std::tuple<int, int>>::value,
+                "Expected a partial invocation to be detected as throwing!");
+}
@@ -110,3 +110,45 @@ TYPED_TEST(single_dimension_tests, are_flow_error_accepting) {
   ASSERT_ASYNC_INCOMPLETION(std::move(continuation));
   ASSERT_TRUE(*handled);
 }
+
+#if !defined(CONTINUABLE_WITH_NO_EXCEPTIONS)
+using cti::detail::types::hybrid_error;
+
+TEST(hybrid_error_tests, is_carrying_error_codes) {
+  hybrid_error error(std::make_error_code(std::errc::timed_out));
+
+  EXPECT_TRUE(bool(error));
+  EXPECT_TRUE(error.is_code());
+  EXPECT_FALSE(error.is_exception());
+  EXPECT_EQ(error.get_code(), std::make_error_code(std::errc::timed_out));
+}
+
+TEST(hybrid_error_tests, is_carrying_exceptions) {
+  hybrid_error error(supply_test_exception());
+
+  EXPECT_TRUE(bool(error));
+  EXPECT_FALSE(error.is_code());
+  EXPECT_TRUE(error.is_exception());
+  EXPECT_THROW(std::rethrow_exception(error), test_exception);
+}
+
+TEST(hybrid_error_tests, is_boxing_error_codes_on_conversion) {
+  hybrid_error error(std::make_error_code(std::errc::timed_out));
+
+  std::exception_ptr exception = error;
+  try {
+    std::rethrow_exception(exception);
+  } catch (std::system_error const& e) {
+    EXPECT_EQ(e.code(), std::make_error_code(std::errc::timed_out));
+  } catch (...) {
+    FAIL();
+  }
+}
+
+TEST(hybrid_error_tests, is_empty_by_default) {
+  hybrid_error error;
+
+  EXPECT_FALSE(bool(error));
+  EXPECT_FALSE(std::exception_ptr(error));
+}
+#endif // CONTINUABLE_WITH_NO_EXCEPTIONS
@@ -0,0 +1,197 @@
+/*
+  Copyright(c) 2015 - 2018 Denis Blank <denis.blank at outlook dot com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files(the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions :
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+**/
+
+#include <string>
+
+#include "test-continuable.hpp"
+
+/// Counts the moves and copies which are applied to the result
+/// while it is passed through the continuation chain.
+struct move_counter {
+  unsigned* moves_;
+  unsigned* copies_;
+
+  explicit move_counter(unsigned* moves, unsigned* copies)
+      : moves_(moves), copies_(copies) {
+  }
+  move_counter(move_counter const& right)
+      : moves_(right.moves_), copies_(right.copies_) {
+    ++*copies_;
+  }
+  move_counter(move_counter&& right)
+      : moves_(right.moves_), copies_(right.copies_) {
+    ++*moves_;
+  }
+  move_counter& operator=(move_counter const&) = delete;
+  move_counter& operator=(move_counter&&) = delete;
+};
+
+TEST(move_counting_tests, results_are_moved_once_into_the_callback) {
+  unsigned moves = 0U;
+  unsigned copies = 0U;
+
+  cti::make_continuable<move_counter>([&](auto&& promise) {
+    promise.set_value(move_counter(&moves, &copies));
+  })
+      .then([](move_counter) {
+        // ...
+      });
+
+  EXPECT_EQ(moves, 1U);
+  EXPECT_EQ(copies, 0U);
+}
+
+TEST(move_counting_tests, results_are_moved_once_per_stage) {
+  unsigned moves = 0U;
+  unsigned copies = 0U;
+
+  // Every stage moves its parameter into the returned value once,
+  // and the returned value is moved once into the next callback.
+  auto const pass = [](move_counter counter) { return counter; };
+
+  cti::make_continuable<move_counter>([&](auto&& promise) {
+    promise.set_value(move_counter(&moves, &copies));
+  })
+      .then(pass)
+      .then(pass)
+      .then(pass)
+      .then([](move_counter) {
+        // ...
+      });
+
+  EXPECT_EQ(moves, 1U + 3U * 2U);
+  EXPECT_EQ(copies, 0U);
+}
+
+TEST(move_counting_tests, lvalue_results_are_copied_once) {
+  unsigned moves = 0U;
+  unsigned copies = 0U;
+  move_counter const counter(&moves, &copies);
+
+  // Callbacks of a by value signature may accept rvalue references,
+  // so an lvalue result is materialized as copy.
+  cti::make_continuable<move_counter>([&](auto&& promise) {
+    promise.set_value(counter);
+  })
+      .then([](move_counter&&) {
+        // ...
+      });
+
+  EXPECT_EQ(moves, 0U);
+  EXPECT_EQ(copies, 1U);
+
+  std::string const value = "value";
+  std::string received;
+  cti::make_continuable<std::string>([&](auto&& promise) {
+    promise.set_value(value);
+  })
+      .then([&](std::string&& result) { received = std::move(result); });
+
+  EXPECT_EQ(received, value);
+}
+
+TEST(move_counting_tests, results_are_forwarded_by_reference) {
+  unsigned moves = 0U;
+  unsigned copies = 0U;
+
+  move_counter counter(&moves, &copies);
+
+  cti::make_continuable<move_counter>([&](auto&& promise) {
+    promise.set_value(std::move(counter));
+  })
+      .fail([](cti::error_type) {
+        // ...
+      })
+      .then([](move_counter&&) {
+        // ...
+      });
+
+  EXPECT_EQ(moves, 0U);
+  EXPECT_EQ(copies, 0U);
+}
+
+TEST(move_counting_tests, tuple_results_are_resolved_in_place) {
+  unsigned moves = 0U;
+  unsigned copies = 0U;
+
+  cti::make_continuable<void>([](auto&& promise) {
+    // ...
+    promise.set_value();
+  })
+      .then([&] {
+        return std::make_tuple(move_counter(&moves, &copies),
+                               move_counter(&moves, &copies));
+      })
+      .then([](move_counter, move_counter) {
+        // ...
+      });
+
+  // Every element is moved into the tuple and from the tuple
+  // into the parameter of the next callback.
+  EXPECT_EQ(moves, 2U * 2U);
+  EXPECT_EQ(copies, 0U);
+}
+
+TEST(move_counting_tests, composed_results_are_resolved_in_place) {
+  unsigned moves = 0U;
+  unsigned copies = 0U;
+
+  auto const supply = [&] {
+    return cti::make_continuable<move_counter>([&](auto&& promise) {
+      promise.set_value(move_counter(&moves, &copies));
+    });
+  };
+
+  // move_counter isn't default constructible, the results are
+  // constructed in place when they arrive.
+  cti::when_all(supply(), supply()).then([](move_counter, move_counter) {
+    // ...
+  });
+
+  // Every result is moved into its slot and from there into the callback.
+  EXPECT_EQ(moves, 2U * 2U);
+  EXPECT_EQ(copies, 0U);
+}
+
+TEST(move_counting_tests, sequential_results_are_resolved_in_place) {
+  unsigned left_moves = 0U;
+  unsigned right_moves = 0U;
+  unsigned copies = 0U;
+
+  auto const supply = [&](unsigned* moves) {
+    return cti::make_continuable<move_counter>([=, &copies](auto&& promise) {
+      promise.set_value(move_counter(moves, &copies));
+    });
+  };
+
+  cti::when_seq(supply(&left_moves), supply(&right_moves))
+      .then([](move_counter&&, move_counter&&) {
+        // ...
+      });
+
+  // The left result is cached until the right one arrives, the right result
+  // is passed by reference into the next callback without any intermediate
+  // tuple.
+  EXPECT_GE(left_moves, 1U);
+  EXPECT_EQ(right_moves, 0U);
+  EXPECT_EQ(copies, 0U);
+}
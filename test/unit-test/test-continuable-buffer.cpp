@@ -0,0 +1,184 @@
+
+/*
+  Copyright(c) 2015 - 2018 Denis Blank <denis.blank at outlook dot com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files(the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions :
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+**/
+
+#include <cstddef>
+#include <string>
+#include <tuple>
+#include <utility>
+
+#include <continuable/continuable-buffer.hpp>
+#include <continuable/continuable.hpp>
+
+#include "test-continuable.hpp"
+
+using cti::io::buffer_chain;
+using cti::io::span;
+
+TEST(buffer_chain_tests, adopts_strings_without_copying) {
+  // Long enough to not be stored inline by the string
+  std::string content(256U, 'x');
+  char const* const data = content.data();
+
+  buffer_chain chain = buffer_chain::adopt(std::move(content));
+  ASSERT_EQ(chain.segment_count(), 1U);
+  ASSERT_EQ(chain.segment(0).data(), data);
+  ASSERT_EQ(chain.to_string(), std::string(256U, 'x'));
+}
+
+TEST(buffer_chain_tests, copies_spans) {
+  std::string const content = "copied";
+  buffer_chain chain = buffer_chain::copy(span(content.data(), content.size()));
+  ASSERT_EQ(chain.size(), content.size());
+  ASSERT_NE(chain.segment(0).data(), content.data());
+  ASSERT_EQ(chain.to_string(), content);
+
+  ASSERT_TRUE(buffer_chain::copy(span()).empty());
+  ASSERT_EQ(buffer_chain::copy(span()).segment_count(), 0U);
+}
+
+TEST(buffer_chain_tests, append_shares_segments) {
+  buffer_chain header = buffer_chain::adopt("header ");
+  buffer_chain body = buffer_chain::adopt("body");
+  char const* const first = header.segment(0).data();
+  char const* const second = body.segment(0).data();
+
+  buffer_chain message;
+  message.append(header);
+  message.append(std::move(body));
+  ASSERT_TRUE(body.empty());
+  ASSERT_EQ(message.size(), 11U);
+  ASSERT_EQ(message.segment_count(), 2U);
+  ASSERT_EQ(message.segment(0).data(), first);
+  ASSERT_EQ(message.segment(1).data(), second);
+  ASSERT_EQ(message.to_string(), "header body");
+
+  // The appended chain keeps its segments
+  ASSERT_EQ(header.segment(0).data(), first);
+}
+
+TEST(buffer_chain_tests, append_to_itself) {
+  buffer_chain chain = buffer_chain::adopt("a");
+  chain.append(buffer_chain::adopt("b"));
+  chain.append(buffer_chain::adopt("c"));
+  char const* const first = chain.segment(0).data();
+
+  chain.append(chain);
+  ASSERT_EQ(chain.size(), 6U);
+  ASSERT_EQ(chain.segment_count(), 6U);
+  ASSERT_EQ(chain.to_string(), "abcabc");
+  ASSERT_EQ(chain.segment(3).data(), first);
+
+  chain.append(std::move(chain));
+  ASSERT_EQ(chain.segment_count(), 12U);
+  ASSERT_EQ(chain.to_string(), "abcabcabcabc");
+}
+
+TEST(buffer_chain_tests, split_shares_the_boundary_segment) {
+  buffer_chain chain = buffer_chain::adopt("abcdef");
+  chain.append(buffer_chain::adopt("ghij"));
+  char const* const first = chain.segment(0).data();
+  char const* const second = chain.segment(1).data();
+
+  buffer_chain front = chain.split(8U);
+  ASSERT_EQ(front.to_string(), "abcdefgh");
+  ASSERT_EQ(chain.to_string(), "ij");
+  ASSERT_EQ(front.segment_count(), 2U);
+  ASSERT_EQ(front.segment(0).data(), first);
+  ASSERT_EQ(front.segment(1).data(), second);
+  ASSERT_EQ(chain.segment(0).data(), second + 2);
+
+  buffer_chain rest = chain.split(chain.size());
+  ASSERT_TRUE(chain.empty());
+  ASSERT_EQ(rest.to_string(), "ij");
+}
+
+TEST(buffer_chain_tests, slice_shares_segments) {
+  buffer_chain chain = buffer_chain::adopt("abc");
+  chain.append(buffer_chain::adopt("def"));
+  chain.append(buffer_chain::adopt("ghi"));
+  char const* const second = chain.segment(1).data();
+
+  buffer_chain middle = chain.slice(4U, 4U);
+  ASSERT_EQ(middle.to_string(), "efgh");
+  ASSERT_EQ(middle.segment_count(), 2U);
+  ASSERT_EQ(middle.segment(0).data(), second + 1);
+  ASSERT_EQ(chain.to_string(), "abcdefghi");
+
+  ASSERT_TRUE(chain.slice(3U, 0U).empty());
+}
+
+TEST(buffer_chain_tests, consume_drops_leading_bytes) {
+  buffer_chain chain = buffer_chain::adopt("abc");
+  chain.append(buffer_chain::adopt("def"));
+
+  chain.consume(4U);
+  ASSERT_EQ(chain.segment_count(), 1U);
+  ASSERT_EQ(chain.to_string(), "ef");
+  chain.consume(2U);
+  ASSERT_TRUE(chain.empty());
+  ASSERT_EQ(chain.segment_count(), 0U);
+}
+
+TEST(buffer_chain_tests, segments_outlive_their_chain) {
+  buffer_chain slice;
+  {
+    buffer_chain chain = buffer_chain::adopt(std::string(64, 'x'));
+    slice = chain.slice(16U, 8U);
+  }
+  ASSERT_EQ(slice.to_string(), std::string(8, 'x'));
+}
+
+TEST(buffer_chain_tests, are_passed_through_compositions_without_copies) {
+  buffer_chain first = buffer_chain::adopt("first");
+  buffer_chain second = buffer_chain::adopt("second");
+  char const* const data = first.segment(0).data();
+
+  auto supply = [](buffer_chain chain) {
+    return cti::make_continuable<buffer_chain>(
+        [chain = std::move(chain)](auto&& promise) mutable {
+          promise.set_value(std::move(chain));
+        });
+  };
+
+  bool finished = false;
+  cti::when_all(supply(std::move(first)), supply(std::move(second)))
+      .then([&](buffer_chain left, buffer_chain right) {
+        left.append(std::move(right));
+        EXPECT_EQ(left.segment(0).data(), data);
+        EXPECT_EQ(left.to_string(), "firstsecond");
+        finished = true;
+      });
+  ASSERT_TRUE(finished);
+}
+
+#if defined(__unix__)
+TEST(buffer_chain_tests, gather_io_vectors) {
+  buffer_chain chain = buffer_chain::adopt("abc");
+  chain.append(buffer_chain::adopt("de"));
+
+  iovec vectors[1];
+  ASSERT_EQ(chain.gather(vectors, 1U), 1U);
+  ASSERT_EQ(vectors[0].iov_base, chain.segment(0).data());
+  ASSERT_EQ(vectors[0].iov_len, 3U);
+}
+#endif // __unix__
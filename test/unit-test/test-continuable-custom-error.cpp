@@ -0,0 +1,57 @@
+
+/*
+  Copyright(c) 2015 - 2018 Denis Blank <denis.blank at outlook dot com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files(the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions :
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+**/
+
+/// This test ensures that the library compiles with a custom error type
+/// which can't be constructed from a std::error_code.
+
+#include <type_traits>
+
+#include <gtest/gtest.h>
+
+struct custom_error {
+  int code;
+};
+
+#define CONTINUABLE_WITH_CUSTOM_ERROR_TYPE custom_error
+
+#include <continuable/continuable.hpp>
+
+static_assert(std::is_same<cti::error_type, custom_error>::value,
+              "Expected the custom error type to be selected!");
+
+TEST(custom_error_tests, pass_custom_errors_through_fail) {
+  int code = 0;
+  cti::make_continuable<int>([](auto&& promise) {
+    promise.set_exception(custom_error{42});
+  })
+      .then([](int) { ADD_FAILURE(); })
+      .fail([&](cti::error_type error) { code = error.code; });
+  ASSERT_EQ(code, 42);
+}
+
+TEST(custom_error_tests, wait_for_custom_errors) {
+  auto result = cti::sync_wait(cti::make_continuable<int>(
+      [](auto&& promise) { promise.set_exception(custom_error{42}); }));
+  ASSERT_TRUE(result.is_exception());
+  ASSERT_EQ(result.get_exception().code, 42);
+}
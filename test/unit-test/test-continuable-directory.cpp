@@ -0,0 +1,274 @@
+
+/*
+  Copyright(c) 2015 - 2018 Denis Blank <denis.blank at outlook dot com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files(the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions :
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+**/
+#include <continuable/detail/features.hpp>
+
+#ifdef CONTINUABLE_HAS_GETDENTS
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <dirent.h>
+#include <sys/stat.h>
+
+#include <continuable/continuable-directory.hpp>
+#include <continuable/continuable-types.hpp>
+
+#include "test-continuable.hpp"
+
+using cti::io::directory_entry;
+using cti::io::directory_walker;
+using cti::io::walk_options;
+
+namespace {
+/// Requests batches until the end of the walk and collects the entries
+void collect(directory_walker& walker, std::vector<directory_entry>& entries,
+             std::function<void()> done) {
+  walker.next().then([&walker, &entries, done = std::move(done)](
+                         std::vector<directory_entry> batch) mutable {
+    if (batch.empty()) {
+      done();
+      return;
+    }
+    for (directory_entry& entry : batch) {
+      entries.push_back(std::move(entry));
+    }
+    collect(walker, entries, std::move(done));
+  });
+}
+
+std::vector<std::string> relative_paths(
+    std::string const& root, std::vector<directory_entry> const& entries) {
+  std::vector<std::string> paths;
+  for (directory_entry const& entry : entries) {
+    EXPECT_EQ(entry.path.compare(0U, root.size() + 1U, root + "/"), 0);
+    paths.push_back(entry.path.substr(root.size() + 1U));
+  }
+  std::sort(paths.begin(), paths.end());
+  return paths;
+}
+
+directory_entry const& find(std::vector<directory_entry> const& entries,
+                            std::string const& path) {
+  auto const itr = std::find_if(
+      entries.begin(), entries.end(),
+      [&](directory_entry const& entry) { return entry.path == path; });
+  EXPECT_NE(itr, entries.end());
+  return *itr;
+}
+} // namespace
+
+TEST(directory_walker_tests, walk_trees_recursively) {
+  temporary_directory tree;
+  tree.file("a");
+  tree.directory("b");
+  tree.file("b/c");
+  tree.directory("b/d");
+  tree.file("b/d/e");
+  tree.link("link", tree.path() + "/b");
+
+  directory_walker walker(tree.path());
+  std::vector<directory_entry> entries;
+  bool finished = false;
+  collect(walker, entries, [&] { finished = true; });
+
+  ASSERT_TRUE(finished);
+  std::vector<std::string> const expected{"a",     "b",   "b/c",
+                                          "b/d",   "b/d/e", "link"};
+  ASSERT_EQ(relative_paths(tree.path(), entries), expected);
+  EXPECT_EQ(find(entries, tree.path() + "/b").type, DT_DIR);
+  EXPECT_EQ(find(entries, tree.path() + "/a").type, DT_REG);
+  // Symbolic links are reported but not followed
+  EXPECT_EQ(find(entries, tree.path() + "/link").type, DT_LNK);
+}
+
+TEST(directory_walker_tests, retrieve_the_status_in_batches) {
+  temporary_directory tree;
+  // More entries than fit into a single chunk or a single batch
+  std::size_t const count = 1500U;
+  for (std::size_t i = 0; i < count; ++i) {
+    tree.file(std::string(48U, 'f') + std::to_string(i),
+              std::string(i % 17U, 'x'));
+  }
+
+  walk_options options;
+  options.status = true;
+  directory_walker walker(tree.path(), options);
+
+  std::vector<directory_entry> entries;
+  std::size_t batches = 0U;
+  std::function<void()> request = [&] {
+    walker.next().then([&](std::vector<directory_entry> batch) {
+      if (!batch.empty()) {
+        ++batches;
+        for (directory_entry& entry : batch) {
+          entries.push_back(std::move(entry));
+        }
+        request();
+      }
+    });
+  };
+  request();
+
+  ASSERT_EQ(entries.size(), count);
+  ASSERT_GT(batches, 1U);
+  for (directory_entry const& entry : entries) {
+    ASSERT_EQ(entry.status_error, 0);
+    ASSERT_TRUE(S_ISREG(entry.status.st_mode));
+    std::size_t const index =
+        std::stoul(entry.path.substr(tree.path().size() + 1U + 48U));
+    ASSERT_EQ(static_cast<std::size_t>(entry.status.st_size), index % 17U);
+  }
+}
+
+TEST(directory_walker_tests, read_directories_through_executors) {
+  temporary_directory tree;
+  std::vector<std::string> expected;
+  for (std::size_t i = 0; i < 8U; ++i) {
+    std::string const directory = "d" + std::to_string(i);
+    tree.directory(directory);
+    expected.push_back(directory);
+    for (std::size_t j = 0; j < 8U; ++j) {
+      std::string const file = directory + "/f" + std::to_string(j);
+      tree.file(file);
+      expected.push_back(file);
+    }
+  }
+  std::sort(expected.begin(), expected.end());
+
+  std::mutex mutex;
+  std::vector<std::thread> threads;
+  auto executor = [&](auto&& work) {
+    std::lock_guard<std::mutex> lock(mutex);
+    threads.emplace_back(std::forward<decltype(work)>(work));
+  };
+
+  std::vector<directory_entry> entries;
+  std::promise<void> finished;
+  {
+    walk_options options;
+    options.concurrency = 3U;
+    directory_walker walker(tree.path(), options, executor);
+    collect(walker, entries, [&] { finished.set_value(); });
+    finished.get_future().wait();
+  }
+
+  std::lock_guard<std::mutex> lock(mutex);
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+  ASSERT_EQ(relative_paths(tree.path(), entries), expected);
+}
+
+TEST(directory_walker_tests, pause_while_the_batches_are_buffered) {
+  temporary_directory tree;
+  // Enough entries for more chunks than batches may be buffered
+  for (std::size_t i = 0; i < 1500U; ++i) {
+    tree.file(std::string(48U, 'f') + std::to_string(i));
+  }
+
+  std::vector<fu2::unique_function<void()>> queue;
+  auto const drain = [&] {
+    while (!queue.empty()) {
+      auto work = std::move(queue.back());
+      queue.pop_back();
+      work();
+    }
+  };
+
+  walk_options options;
+  options.concurrency = 1U;
+  directory_walker walker(
+      tree.path(), options,
+      [&](auto&& work) { queue.emplace_back(std::move(work)); });
+
+  std::size_t received = 0U;
+  auto const request = [&] {
+    walker.next().then([&](std::vector<directory_entry> batch) {
+      received += batch.size();
+    });
+  };
+
+  request();
+  drain();
+  ASSERT_GT(received, 0U);
+
+  // The reader is parked after it buffered a single batch and resumed
+  // once the batch was taken.
+  std::size_t const first = received;
+  request();
+  ASSERT_GT(received, first);
+  ASSERT_EQ(queue.size(), 1U);
+
+  while (received < 1500U) {
+    drain();
+    request();
+  }
+  drain();
+  ASSERT_EQ(received, 1500U);
+}
+
+TEST(directory_walker_tests, reject_unreadable_directories) {
+  directory_walker walker("/tmp/continuable-directory-missing");
+
+  bool rejected = false;
+  walker.next()
+      .then([](std::vector<directory_entry>) { FAIL(); })
+      .fail([&](cti::error_type) { rejected = true; });
+  ASSERT_TRUE(rejected);
+
+  // The walk continues after the error
+  bool finished = false;
+  walker.next().then([&](std::vector<directory_entry> batch) {
+    EXPECT_TRUE(batch.empty());
+    finished = true;
+  });
+  ASSERT_TRUE(finished);
+}
+
+TEST(directory_walker_tests, are_cancelled_on_destruction) {
+  temporary_directory tree;
+  tree.file("a");
+
+  // An executor which drops its work
+  std::size_t dropped = 0U;
+  bool cancelled = false;
+  {
+    directory_walker walker(tree.path(), walk_options(),
+                            [&](auto&&) { ++dropped; });
+    walker.next()
+        .then([](std::vector<directory_entry>) { FAIL(); })
+        .fail([&](cti::error_type) { cancelled = true; });
+    ASSERT_FALSE(cancelled);
+    ASSERT_EQ(dropped, 1U);
+  }
+  ASSERT_TRUE(cancelled);
+}
+
+#endif // CONTINUABLE_HAS_GETDENTS
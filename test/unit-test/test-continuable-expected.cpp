@@ -221,3 +221,20 @@ TEST(expected_single_test, test_leak_regression) {
 
   ASSERT_TRUE(destroyed);
 }
+
+TEST(expected_single_test, is_trivially_copyable_for_trivial_types) {
+  using trivial_error = std::is_trivially_copyable<error_type>;
+
+  EXPECT_EQ(std::is_trivially_copyable<expected<int>>::value,
+            trivial_error::value);
+  EXPECT_FALSE(std::is_trivially_copyable<unique_type>::value);
+}
+
+TEST(expected_single_test, is_copyable_and_movable) {
+  copyable_type const e_old(CANARY);
+  copyable_type e(e_old);
+  copyable_type moved(std::move(e));
+
+  EXPECT_TRUE(bool(moved));
+  EXPECT_EQ(*moved, CANARY);
+}
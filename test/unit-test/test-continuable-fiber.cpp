@@ -0,0 +1,180 @@
+
+/*
+  Copyright(c) 2015 - 2018 Denis Blank <denis.blank at outlook dot com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files(the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions :
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+**/
+
+#include <continuable/detail/features.hpp>
+
+#ifdef CONTINUABLE_HAS_FIBERS
+
+#include <cmath>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+#include <continuable/continuable-fiber.hpp>
+
+#include "test-continuable.hpp"
+
+TEST(fiber_tests, await_synchronous_continuables) {
+  cti::fiber_scheduler scheduler;
+
+  bool finished = false;
+  scheduler.spawn([&] {
+    cti::this_fiber::await(cti::make_continuable<void>(
+        [](auto&& promise) { promise.set_value(); }));
+
+    int a = cti::this_fiber::await(cti::make_continuable<int>(
+        [](auto&& promise) { promise.set_value(1); }));
+    EXPECT_EQ(a, 1);
+
+    std::tuple<int, int> b =
+        cti::this_fiber::await(cti::make_continuable<int, int>(
+            [](auto&& promise) { promise.set_value(2, 3); }));
+    EXPECT_EQ(b, std::make_tuple(2, 3));
+
+    finished = true;
+  });
+
+  ASSERT_FALSE(finished);
+  scheduler.run();
+  ASSERT_TRUE(finished);
+}
+
+TEST(fiber_tests, park_only_the_fiber) {
+  cti::fiber_scheduler scheduler;
+
+  std::vector<cti::promise<int>> pending;
+  std::vector<int> results;
+
+  int const count = 1000;
+  for (int i = 0; i < count; ++i) {
+    scheduler.spawn([&] {
+      results.push_back(cti::this_fiber::await(cti::make_continuable<int>(
+          [&](auto&& promise) { pending.emplace_back(std::move(promise)); })));
+    });
+  }
+
+  // A fiber which resolves the others after all of them were parked
+  scheduler.spawn([&] {
+    EXPECT_EQ(pending.size(), static_cast<std::size_t>(count));
+    EXPECT_TRUE(results.empty());
+    for (int i = 0; i < count; ++i) {
+      std::move(pending[i]).set_value(i);
+    }
+  });
+
+  scheduler.run();
+  ASSERT_EQ(results.size(), static_cast<std::size_t>(count));
+}
+
+TEST(fiber_tests, are_resumed_from_other_threads) {
+  cti::fiber_scheduler scheduler;
+
+  std::thread::id resumed;
+  scheduler.spawn([&] {
+    int value = cti::this_fiber::await(
+        cti::make_continuable<int>([](auto&& promise) {
+          std::thread([promise = std::forward<decltype(promise)>(
+                           promise)]() mutable { promise.set_value(1); })
+              .detach();
+        }));
+    EXPECT_EQ(value, 1);
+    resumed = std::this_thread::get_id();
+  });
+
+  scheduler.run();
+  ASSERT_EQ(resumed, std::this_thread::get_id());
+}
+
+TEST(fiber_tests, preserve_the_floating_point_state) {
+  cti::fiber_scheduler scheduler;
+
+  double result = 0.0;
+  scheduler.spawn([&] {
+    double const value = std::sqrt(2.0);
+    cti::this_fiber::await(cti::make_continuable<void>(
+        [](auto&& promise) { std::thread(std::move(promise)).detach(); }));
+    result = value * value;
+  });
+
+  scheduler.run();
+  ASSERT_NEAR(result, 2.0, 1e-9);
+}
+
+TEST(fiber_tests, await_expected) {
+  cti::fiber_scheduler scheduler;
+
+  scheduler.spawn([&] {
+    auto result = cti::this_fiber::await_expected(
+        cti::make_continuable<int>([](auto&& promise) {
+          promise.set_exception(supply_test_exception());
+        }));
+    EXPECT_TRUE(result.is_exception());
+  });
+
+  scheduler.run();
+}
+
+#ifndef CONTINUABLE_WITH_NO_EXCEPTIONS
+
+struct fiber_exception : std::exception {};
+
+TEST(fiber_tests, rethrow_errors) {
+  cti::fiber_scheduler scheduler;
+
+  bool caught = false;
+  scheduler.spawn([&] {
+    try {
+      cti::this_fiber::await(cti::make_continuable<void>(
+          [](auto&& promise) { promise.set_value(); })
+                                 .then([] { throw fiber_exception{}; }));
+    } catch (fiber_exception const&) {
+      caught = true;
+    }
+  });
+  scheduler.run();
+  ASSERT_TRUE(caught);
+
+  scheduler.spawn([] { throw fiber_exception{}; });
+  ASSERT_THROW(scheduler.run(), fiber_exception);
+}
+
+TEST(fiber_tests, drain_the_remaining_fibers_before_rethrowing) {
+  cti::fiber_scheduler scheduler;
+
+  std::vector<cti::promise<>> pending;
+  bool finished = false;
+  scheduler.spawn([&] {
+    cti::this_fiber::await(cti::make_continuable<void>(
+        [&](auto&& promise) { pending.emplace_back(std::move(promise)); }));
+    finished = true;
+  });
+  scheduler.spawn([] { throw fiber_exception{}; });
+  scheduler.spawn([&] { pending.front().set_value(); });
+
+  ASSERT_THROW(scheduler.run(), fiber_exception);
+  ASSERT_TRUE(finished);
+}
+
+#endif // CONTINUABLE_WITH_NO_EXCEPTIONS
+
+#endif // CONTINUABLE_HAS_FIBERS
@@ -0,0 +1,190 @@
+
+/*
+  Copyright(c) 2015 - 2018 Denis Blank <denis.blank at outlook dot com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files(the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions :
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+**/
+
+#include <continuable/detail/features.hpp>
+
+#ifdef CONTINUABLE_HAS_COROUTINE
+
+#ifndef CONTINUABLE_WITH_NO_EXCEPTIONS
+#include <exception>
+#endif // CONTINUABLE_WITH_NO_EXCEPTIONS
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "test-continuable.hpp"
+
+static cti::async_generator<int> count_to(int count) {
+  for (int i = 1; i <= count; ++i) {
+    co_yield i;
+  }
+}
+
+static cti::continuable<int> sum_of(cti::async_generator<int> generator) {
+  int sum = 0;
+  while (int* current = co_await generator.next()) {
+    sum += *current;
+  }
+  co_return sum;
+}
+
+TEST(generator_tests, are_consumable_through_await) {
+  ASSERT_ASYNC_RESULT(sum_of(count_to(0)), 0);
+  ASSERT_ASYNC_RESULT(sum_of(count_to(10)), 55);
+}
+
+TEST(generator_tests, are_started_lazily) {
+  bool started = false;
+  auto generator = [&]() -> cti::async_generator<int> {
+    started = true;
+    co_yield 1;
+  };
+
+  auto current = generator();
+  ASSERT_FALSE(started);
+  ASSERT_ASYNC_TYPES(current.next(), int*);
+  ASSERT_TRUE(started);
+}
+
+TEST(generator_tests, are_consumable_through_then) {
+  auto generator = count_to(2);
+
+  std::vector<int> pulled;
+  auto const& pull = [&] {
+    generator.next().then([&](int* current) {
+      pulled.push_back(current ? *current : 0);
+    });
+  };
+
+  pull();
+  pull();
+  pull();
+  // Pulling from an ended generator resolves with a nullptr again
+  pull();
+
+  ASSERT_EQ(pulled, (std::vector<int>{1, 2, 0, 0}));
+}
+
+TEST(generator_tests, keep_pulled_continuables_valid_across_moves) {
+  auto generator = count_to(1);
+  auto pulled = generator.next();
+
+  // The continuable refers to the frame, which is owned by the
+  // generator it was moved to.
+  auto moved = std::move(generator);
+  int result = 0;
+  std::move(pulled).then([&](int* current) {
+    ASSERT_TRUE(current);
+    result = *current;
+  });
+  ASSERT_EQ(result, 1);
+}
+
+TEST(generator_tests, do_not_copy_elements) {
+  auto generator = []() -> cti::async_generator<std::unique_ptr<int>> {
+    co_yield std::make_unique<int>(1);
+    auto local = std::make_unique<int>(2);
+    co_yield local;
+    // The yielded element may be moved out by the consumer
+    EXPECT_FALSE(local);
+  };
+
+  auto current = generator();
+  current.next().then([](std::unique_ptr<int>* element) {
+    ASSERT_TRUE(element);
+    EXPECT_EQ(**element, 1);
+  });
+  current.next().then([](std::unique_ptr<int>* element) {
+    ASSERT_TRUE(element);
+    std::unique_ptr<int> moved = std::move(*element);
+    EXPECT_EQ(*moved, 2);
+  });
+  ASSERT_ASYNC_RESULT(current.next(), nullptr);
+}
+
+static cti::async_generator<std::string>
+produce_async(std::optional<cti::promise<std::string>>& pending) {
+  for (int i = 0; i < 2; ++i) {
+    co_yield co_await cti::make_continuable<std::string>(
+        [&](auto&& promise) { pending.emplace(std::move(promise)); });
+  }
+}
+
+static cti::continuable<std::string>
+concat_of(cti::async_generator<std::string> generator) {
+  std::string result;
+  while (std::string* current = co_await generator.next()) {
+    result += *current;
+  }
+  co_return result;
+}
+
+TEST(generator_tests, are_resolvable_asynchronously) {
+  std::optional<cti::promise<std::string>> pending;
+  std::optional<std::string> result;
+
+  concat_of(produce_async(pending)).then([&](std::string concatenated) {
+    result = std::move(concatenated);
+  });
+
+  ASSERT_TRUE(pending);
+  std::exchange(pending, std::nullopt)->set_value("hello ");
+  ASSERT_FALSE(result);
+  ASSERT_TRUE(pending);
+  std::exchange(pending, std::nullopt)->set_value("world");
+  ASSERT_TRUE(result);
+  ASSERT_EQ(*result, "hello world");
+}
+
+TEST(generator_tests, are_consumable_without_stack_growth) {
+  // The consumer is resumed through symmetric transfer or
+  // continues synchronously, otherwise this would exhaust the stack.
+  ASSERT_ASYNC_RESULT(sum_of(count_to(50000)), 1250025000);
+}
+
+#ifndef CONTINUABLE_WITH_NO_EXCEPTIONS
+
+struct generator_exception : std::exception {
+  char const* what() const noexcept override {
+    return "generator_exception";
+  }
+
+  bool operator==(generator_exception const&) const noexcept {
+    return true;
+  }
+};
+
+TEST(generator_tests, are_rejected_through_exceptions) {
+  auto generator = []() -> cti::async_generator<int> {
+    co_yield 1;
+    throw generator_exception{};
+  };
+
+  ASSERT_ASYNC_EXCEPTION_RESULT(sum_of(generator()), generator_exception{});
+}
+
+#endif // CONTINUABLE_WITH_NO_EXCEPTIONS
+
+#endif // CONTINUABLE_HAS_COROUTINE
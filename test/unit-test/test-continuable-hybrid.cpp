@@ -0,0 +1,83 @@
+
+/*
+  Copyright(c) 2015 - 2018 Denis Blank <denis.blank at outlook dot com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files(the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions :
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+**/
+
+#include <exception>
+#include <system_error>
+#include <type_traits>
+
+#include "test-continuable.hpp"
+
+#if defined(CONTINUABLE_WITH_HYBRID_ERROR_TYPE) &&                             \
+    !defined(CONTINUABLE_WITH_NO_EXCEPTIONS)
+static_assert(
+    std::is_same<cti::error_type, cti::detail::types::hybrid_error>::value,
+    "Expected the hybrid error type to be selected!");
+
+namespace {
+auto fail_with_code() {
+  return cti::make_continuable<int>([](auto&& promise) {
+    promise.set_exception(std::make_error_code(std::errc::timed_out));
+  });
+}
+} // namespace
+
+TEST(hybrid_error_chain_tests, pass_error_codes_through_fail) {
+  bool handled = false;
+  fail_with_code()
+      .then([](int) { ADD_FAILURE(); })
+      .fail([&](cti::error_type error) {
+        EXPECT_TRUE(error.is_code());
+        EXPECT_FALSE(error.is_exception());
+        EXPECT_EQ(error.get_code(), std::make_error_code(std::errc::timed_out));
+        handled = true;
+      });
+  ASSERT_TRUE(handled);
+}
+
+TEST(hybrid_error_chain_tests, pass_thrown_exceptions_through_fail) {
+  bool handled = false;
+  empty_continuable()
+      .then([] { throw test_exception{}; })
+      .fail([&](cti::error_type error) {
+        EXPECT_FALSE(error.is_code());
+        EXPECT_TRUE(error.is_exception());
+        EXPECT_THROW(std::rethrow_exception(error.get_exception()),
+                     test_exception);
+        handled = true;
+      });
+  ASSERT_TRUE(handled);
+}
+
+TEST(hybrid_error_chain_tests, box_error_codes_for_exception_handlers) {
+  bool handled = false;
+  fail_with_code().fail([&](std::exception_ptr exception) {
+    try {
+      std::rethrow_exception(exception);
+    } catch (std::system_error const& e) {
+      EXPECT_EQ(e.code(), std::make_error_code(std::errc::timed_out));
+      handled = true;
+    }
+  });
+  ASSERT_TRUE(handled);
+}
+#endif // CONTINUABLE_WITH_HYBRID_ERROR_TYPE
@@ -0,0 +1,200 @@
+
+/*
+  Copyright(c) 2015 - 2018 Denis Blank <denis.blank at outlook dot com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files(the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions :
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+**/
+#include <continuable/detail/features.hpp>
+
+#ifdef CONTINUABLE_HAS_MMAP
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include <continuable/continuable-mmap.hpp>
+#include <continuable/continuable-types.hpp>
+
+#include "test-continuable.hpp"
+
+namespace {
+std::string make_content(std::size_t size) {
+  std::string content(size, '\0');
+  for (std::size_t i = 0; i < size; ++i) {
+    content[i] = static_cast<char>('a' + (i % 26));
+  }
+  return content;
+}
+} // namespace
+
+TEST(mapped_reader_tests, read_chunks_without_copying) {
+  std::string const content = make_content(10000);
+  temporary_file file(content);
+  cti::io::mapped_reader reader(file.path(), 4096);
+  ASSERT_EQ(reader.size(), content.size());
+
+  std::vector<cti::io::span> chunks;
+  bool finished = false;
+  reader.for_each([&](cti::io::span chunk) { chunks.push_back(chunk); })
+      .then([&] { finished = true; });
+
+  ASSERT_TRUE(finished);
+  ASSERT_EQ(chunks.size(), 3U);
+  ASSERT_EQ(chunks[2].size(), 10000U - 2U * 4096U);
+
+  std::string read;
+  for (std::size_t i = 0; i < chunks.size(); ++i) {
+    // Every chunk points into the same mapping
+    ASSERT_EQ(chunks[i].data(), chunks[0].data() + i * 4096U);
+    read.append(chunks[i].begin(), chunks[i].end());
+  }
+  ASSERT_EQ(read, content);
+}
+
+TEST(mapped_reader_tests, produce_chunks_on_demand) {
+  std::string const content = make_content(100);
+  temporary_file file(content);
+  cti::io::mapped_reader reader(file.path(), 60);
+
+  std::size_t read = 0;
+  reader.next().then([&](cti::io::span chunk) { read += chunk.size(); });
+  ASSERT_EQ(read, 60U);
+  ASSERT_EQ(reader.position(), 60U);
+
+  reader.next().then([&](cti::io::span chunk) { read += chunk.size(); });
+  ASSERT_EQ(read, 100U);
+
+  bool finished = false;
+  reader.next().then([&](cti::io::span chunk) {
+    EXPECT_TRUE(chunk.empty());
+    finished = true;
+  });
+  ASSERT_TRUE(finished);
+}
+
+TEST(mapped_reader_tests, wait_for_the_previous_stage) {
+  std::string const content = make_content(300);
+  temporary_file file(content);
+  cti::io::mapped_reader reader(file.path(), 100);
+
+  std::vector<cti::promise<>> stages;
+  bool finished = false;
+  reader
+      .for_each([&](cti::io::span) {
+        return cti::make_continuable<void>([&](cti::promise<> promise) {
+          stages.push_back(std::move(promise));
+        });
+      })
+      .then([&] { finished = true; });
+
+  // The next chunk is produced only when the stage resolved
+  ASSERT_EQ(stages.size(), 1U);
+  ASSERT_EQ(reader.position(), 100U);
+
+  stages[0].set_value();
+  ASSERT_EQ(stages.size(), 2U);
+  ASSERT_EQ(reader.position(), 200U);
+
+  stages[1].set_value();
+  ASSERT_EQ(stages.size(), 3U);
+  ASSERT_FALSE(finished);
+
+  stages[2].set_value();
+  ASSERT_TRUE(finished);
+}
+
+TEST(mapped_reader_tests, invoke_the_stages_through_the_executor) {
+  std::string const content = make_content(300);
+  temporary_file file(content);
+  cti::io::mapped_reader reader(file.path(), 100);
+
+  // An executor which defers its work until it is drained
+  std::vector<fu2::unique_function<void()>> queue;
+  auto executor = [&](auto&& work) {
+    queue.emplace_back(std::forward<decltype(work)>(work));
+  };
+
+  std::string read;
+  bool finished = false;
+  reader
+      .for_each(
+          [&](cti::io::span chunk) {
+            read.append(chunk.begin(), chunk.end());
+          },
+          executor)
+      .then([&] { finished = true; });
+
+  for (std::size_t i = 0; i < 3U; ++i) {
+    // Every stage is invoked only when the executor runs its work
+    ASSERT_EQ(queue.size(), 1U);
+    ASSERT_EQ(read.size(), i * 100U);
+    auto work = std::move(queue.front());
+    queue.erase(queue.begin());
+    std::move(work)();
+  }
+
+  ASSERT_TRUE(queue.empty());
+  ASSERT_TRUE(finished);
+  ASSERT_EQ(read, content);
+}
+
+TEST(mapped_reader_tests, drive_many_chunks_iteratively) {
+  std::size_t const size = 1000000;
+  std::string const content = make_content(size);
+  temporary_file file(content);
+
+  // Synchronous stages mustn't grow the stack per chunk
+  cti::io::mapped_reader reader(file.path(), 1);
+  std::size_t count = 0;
+  reader.for_each([&](cti::io::span chunk) { count += chunk.size(); });
+  ASSERT_EQ(count, size);
+}
+
+TEST(mapped_reader_tests, stop_on_failure) {
+  std::string const content = make_content(300);
+  temporary_file file(content);
+  cti::io::mapped_reader reader(file.path(), 100);
+
+  std::size_t invoked = 0;
+  bool rejected = false;
+  reader
+      .for_each([&](cti::io::span) {
+        ++invoked;
+        return cti::make_continuable<void>([](auto&& promise) {
+          promise.set_exception(supply_test_exception());
+        });
+      })
+      .fail([&](cti::error_type) { rejected = true; });
+
+  ASSERT_TRUE(rejected);
+  ASSERT_EQ(invoked, 1U);
+}
+
+TEST(mapped_reader_tests, read_empty_files) {
+  temporary_file file("");
+  cti::io::mapped_reader reader(file.path());
+
+  bool finished = false;
+  reader.for_each([](cti::io::span) { FAIL(); }).then([&] {
+    finished = true;
+  });
+  ASSERT_TRUE(finished);
+}
+
+#endif // CONTINUABLE_HAS_MMAP
@@ -0,0 +1,223 @@
+
+/*
+  Copyright(c) 2015 - 2018 Denis Blank <denis.blank at outlook dot com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files(the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions :
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+**/
+#include <continuable/detail/features.hpp>
+
+#ifdef CONTINUABLE_HAS_EPOLL
+
+#include <array>
+#include <csignal>
+#include <cstddef>
+#include <cstdlib>
+#include <memory>
+#include <string>
+
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <continuable/continuable-process.hpp>
+#include <continuable/continuable-reactor.hpp>
+
+#include "test-continuable.hpp"
+
+namespace {
+/// Reads the descriptor through the reactor until its end
+void read_all(cti::io::reactor& reactor, int fd, std::string& output) {
+  auto buffer = std::make_shared<std::array<char, 4096>>();
+  reactor.async_read_some(fd, buffer->data(), buffer->size())
+      .then([&reactor, fd, &output, buffer](std::size_t count) {
+        if (count) {
+          output.append(buffer->data(), count);
+          read_all(reactor, fd, output);
+        }
+      });
+}
+
+std::string make_sequence(int count) {
+  std::string sequence;
+  for (int i = 1; i <= count; ++i) {
+    sequence += std::to_string(i) + "\n";
+  }
+  return sequence;
+}
+} // namespace
+
+TEST(process_tests, resolve_with_the_exit_status) {
+  cti::io::reactor reactor;
+  cti::io::process child = cti::io::spawn({"sh", "-c", "exit 3"});
+
+  int status = -1;
+  reactor.async_wait(child).then([&](int code) { status = code; });
+
+  reactor.run();
+  ASSERT_EQ(status, 3);
+  ASSERT_EQ(reactor.pending(), 0U);
+}
+
+TEST(process_tests, resolve_with_the_terminating_signal) {
+  cti::io::reactor reactor;
+  cti::io::process child = cti::io::spawn({"sleep", "10"});
+
+  int status = -1;
+  reactor.async_wait(child).then([&](int code) { status = code; });
+  ASSERT_EQ(reactor.pending(), 1U);
+
+  ::kill(child.pid(), SIGKILL);
+  reactor.run();
+  ASSERT_EQ(status, 128 + SIGKILL);
+}
+
+TEST(process_tests, read_the_output) {
+  cti::io::reactor reactor;
+  cti::io::spawn_options options;
+  options.pipe_stdout = true;
+  cti::io::process child = cti::io::spawn({"echo", "hello"}, options);
+
+  std::string output;
+  read_all(reactor, child.stdout_fd(), output);
+  int status = -1;
+  reactor.async_wait(child).then([&](int code) { status = code; });
+
+  reactor.run();
+  ASSERT_EQ(output, "hello\n");
+  ASSERT_EQ(status, 0);
+  reactor.release(child.stdout_fd());
+}
+
+TEST(process_tests, write_the_input) {
+  cti::io::reactor reactor;
+  cti::io::spawn_options options;
+  options.pipe_stdin = true;
+  options.pipe_stdout = true;
+  cti::io::process child = cti::io::spawn({"cat"}, options);
+
+  // The input exceeds the capacity of the pipe
+  std::string const input = make_sequence(100000);
+  reactor.async_write(child.stdin_fd(), input.data(), input.size())
+      .then([&](std::size_t written) {
+        EXPECT_EQ(written, input.size());
+        reactor.release(child.stdin_fd());
+        child.close_stdin();
+      });
+
+  std::string output;
+  read_all(reactor, child.stdout_fd(), output);
+  reactor.async_wait(child);
+
+  reactor.run();
+  ASSERT_EQ(output, input);
+  reactor.release(child.stdout_fd());
+}
+
+TEST(process_tests, forward_the_output_without_copying) {
+  cti::io::reactor reactor;
+  cti::io::spawn_options options;
+  options.pipe_stdout = true;
+  cti::io::process child = cti::io::spawn({"seq", "1", "100000"}, options);
+
+  char path[] = "/tmp/continuable-process-XXXXXX";
+  int const file = ::mkstemp(path);
+  ASSERT_GE(file, 0);
+
+  std::size_t forwarded = 0;
+  reactor.async_forward(child.stdout_fd(), file)
+      .then([&](std::size_t count) { forwarded = count; });
+  reactor.async_wait(child);
+
+  reactor.run();
+  reactor.release(child.stdout_fd());
+
+  std::string const expected = make_sequence(100000);
+  ASSERT_EQ(forwarded, expected.size());
+
+  std::string content(expected.size(), '\0');
+  ASSERT_EQ(::pread(file, &content[0], content.size(), 0),
+            static_cast<ssize_t>(content.size()));
+  ASSERT_EQ(content, expected);
+
+  ::close(file);
+  ::unlink(path);
+}
+
+TEST(process_tests, forward_into_slow_destinations) {
+  cti::io::reactor reactor;
+  cti::io::spawn_options options;
+  options.pipe_stdout = true;
+  cti::io::process child = cti::io::spawn({"seq", "1", "200000"}, options);
+
+  int sockets[2];
+  ASSERT_EQ(::socketpair(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC,
+                         0, sockets),
+            0);
+
+  // The transfer blocks on the source and the destination alternately
+  std::string output;
+  reactor.async_forward(child.stdout_fd(), sockets[0])
+      .then([&](std::size_t) {
+        reactor.release(sockets[0]);
+        ::shutdown(sockets[0], SHUT_WR);
+      });
+  read_all(reactor, sockets[1], output);
+  reactor.async_wait(child);
+
+  reactor.run();
+  ASSERT_EQ(output, make_sequence(200000));
+
+  reactor.release(child.stdout_fd());
+  reactor.release(sockets[1]);
+  ::close(sockets[0]);
+  ::close(sockets[1]);
+}
+
+TEST(process_tests, duplicate_pipes_through_tee) {
+  cti::io::reactor reactor;
+
+  int source[2];
+  int destination[2];
+  ASSERT_EQ(::pipe2(source, O_NONBLOCK | O_CLOEXEC), 0);
+  ASSERT_EQ(::pipe2(destination, O_NONBLOCK | O_CLOEXEC), 0);
+
+  std::size_t duplicated = 0;
+  reactor.async_tee(source[0], destination[1], 64)
+      .then([&](std::size_t count) { duplicated = count; });
+
+  // The tee waits until the source becomes readable
+  ASSERT_EQ(reactor.pending(), 1U);
+  ASSERT_EQ(::write(source[1], "hello", 5), 5);
+  reactor.run();
+  ASSERT_EQ(duplicated, 5U);
+
+  // The bytes are available in both pipes
+  char buffer[8];
+  ASSERT_EQ(::read(destination[0], buffer, sizeof(buffer)), 5);
+  ASSERT_EQ(std::string(buffer, 5), "hello");
+  ASSERT_EQ(::read(source[0], buffer, sizeof(buffer)), 5);
+  ASSERT_EQ(std::string(buffer, 5), "hello");
+
+  reactor.release(source[0]);
+  for (int fd : {source[0], source[1], destination[0], destination[1]}) {
+    ::close(fd);
+  }
+}
+
+#endif // CONTINUABLE_HAS_EPOLL
@@ -0,0 +1,427 @@
+
+/*
+  Copyright(c) 2015 - 2018 Denis Blank <denis.blank at outlook dot com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files(the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions :
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+**/
+#include <continuable/detail/features.hpp>
+
+#ifdef CONTINUABLE_HAS_EPOLL
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <continuable/continuable-reactor.hpp>
+
+#include "test-continuable.hpp"
+
+namespace {
+/// A connected pair of non-blocking stream sockets
+class socket_pair {
+  int fds_[2];
+
+public:
+  socket_pair() {
+    int const result = ::socketpair(
+        AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0, fds_);
+    EXPECT_EQ(result, 0);
+  }
+  ~socket_pair() {
+    ::close(fds_[0]);
+    ::close(fds_[1]);
+  }
+
+  int first() const noexcept {
+    return fds_[0];
+  }
+  int second() const noexcept {
+    return fds_[1];
+  }
+};
+
+/// A non-blocking datagram socket which is bound to the loopback interface
+class loopback_socket {
+  int fd_;
+  sockaddr_in address_{};
+
+public:
+  loopback_socket()
+      : fd_(::socket(AF_INET, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0)) {
+    address_.sin_family = AF_INET;
+    address_.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    socklen_t length = sizeof(address_);
+    EXPECT_EQ(::bind(fd_, reinterpret_cast<sockaddr*>(&address_), length), 0);
+    EXPECT_EQ(
+        ::getsockname(fd_, reinterpret_cast<sockaddr*>(&address_), &length),
+        0);
+  }
+  ~loopback_socket() {
+    ::close(fd_);
+  }
+
+  int fd() const noexcept {
+    return fd_;
+  }
+  sockaddr const* address() const noexcept {
+    return reinterpret_cast<sockaddr const*>(&address_);
+  }
+  socklen_t address_size() const noexcept {
+    return sizeof(address_);
+  }
+};
+} // namespace
+
+TEST(reactor_tests, read_what_was_written) {
+  cti::io::reactor reactor;
+  socket_pair sockets;
+
+  std::string const content = "hello epoll";
+  std::string read(content.size(), '\0');
+  bool finished = false;
+
+  reactor.async_read_some(sockets.second(), &read[0], read.size())
+      .then([&](std::size_t count) {
+        EXPECT_EQ(count, content.size());
+        finished = true;
+      });
+
+  // The read would block and is suspended until the data arrives
+  ASSERT_EQ(reactor.pending(), 1U);
+  ASSERT_FALSE(finished);
+
+  reactor.async_write(sockets.first(), content.data(), content.size())
+      .then([&](std::size_t written) { EXPECT_EQ(written, content.size()); });
+
+  reactor.run();
+  ASSERT_TRUE(finished);
+  ASSERT_EQ(read, content);
+  ASSERT_EQ(reactor.pending(), 0U);
+}
+
+TEST(reactor_tests, write_more_than_the_socket_buffers) {
+  cti::io::reactor reactor;
+  socket_pair sockets;
+
+  std::size_t const size = 4U * 1024U * 1024U;
+  std::vector<char> content(size);
+  for (std::size_t i = 0; i < size; ++i) {
+    content[i] = static_cast<char>(i % 251);
+  }
+
+  std::vector<char> read(size);
+  std::size_t received = 0U;
+  std::function<void()> receive = [&] {
+    reactor
+        .async_read_some(sockets.second(), &read[received],
+                         std::min<std::size_t>(size - received, 64U * 1024U))
+        .then([&](std::size_t count) {
+          ASSERT_NE(count, 0U);
+          received += count;
+          if (received < size) {
+            receive();
+          }
+        });
+  };
+
+  bool written = false;
+  reactor.async_write(sockets.first(), content.data(), size)
+      .then([&](std::size_t count) {
+        EXPECT_EQ(count, size);
+        written = true;
+      });
+  ASSERT_FALSE(written);
+
+  receive();
+  reactor.run();
+  ASSERT_TRUE(written);
+  ASSERT_EQ(received, size);
+  ASSERT_EQ(read, content);
+}
+
+TEST(reactor_tests, write_buffer_chains_through_writev) {
+  cti::io::reactor reactor;
+  socket_pair sockets;
+
+  // More segments than are written per call and more bytes than the
+  // socket buffers hold, so the write is suspended and resumed.
+  std::string expected;
+  cti::io::buffer_chain chain;
+  for (std::size_t i = 0; i < 100U; ++i) {
+    std::string segment(32U * 1024U, static_cast<char>('a' + i % 26));
+    expected += segment;
+    chain.append(cti::io::buffer_chain::adopt(std::move(segment)));
+  }
+
+  bool written = false;
+  reactor.async_write(sockets.first(), std::move(chain))
+      .then([&](std::size_t count) {
+        EXPECT_EQ(count, expected.size());
+        written = true;
+      });
+  ASSERT_FALSE(written);
+
+  cti::io::buffer_chain received;
+  std::function<void()> receive = [&] {
+    reactor.async_read_chain(sockets.second(), 64U * 1024U)
+        .then([&](cti::io::buffer_chain bytes) {
+          ASSERT_FALSE(bytes.empty());
+          received.append(std::move(bytes));
+          if (received.size() < expected.size()) {
+            receive();
+          }
+        });
+  };
+
+  receive();
+  reactor.run();
+  ASSERT_TRUE(written);
+  ASSERT_EQ(received.to_string(), expected);
+}
+
+TEST(reactor_tests, read_chains_until_the_end_of_the_stream) {
+  cti::io::reactor reactor;
+  socket_pair sockets;
+
+  bool finished = false;
+  reactor.async_read_chain(sockets.second(), 16U)
+      .then([&](cti::io::buffer_chain bytes) {
+        EXPECT_TRUE(bytes.empty());
+        finished = true;
+      });
+  ASSERT_EQ(reactor.pending(), 1U);
+
+  ::shutdown(sockets.first(), SHUT_WR);
+  reactor.run();
+  ASSERT_TRUE(finished);
+}
+
+TEST(reactor_tests, accept_connections) {
+  cti::io::reactor reactor;
+
+  int const listener =
+      ::socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+  ASSERT_GE(listener, 0);
+
+  sockaddr_in address{};
+  address.sin_family = AF_INET;
+  address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  address.sin_port = 0;
+  socklen_t length = sizeof(address);
+  ASSERT_EQ(::bind(listener, reinterpret_cast<sockaddr*>(&address), length),
+            0);
+  ASSERT_EQ(::listen(listener, 8), 0);
+  ASSERT_EQ(
+      ::getsockname(listener, reinterpret_cast<sockaddr*>(&address), &length),
+      0);
+
+  int accepted = -1;
+  char buffer[4] = {};
+  reactor.async_accept(listener)
+      .then([&](int connection) {
+        accepted = connection;
+        return reactor.async_read_some(connection, buffer, sizeof(buffer));
+      })
+      .then([&](std::size_t count) { EXPECT_EQ(count, 4U); });
+  ASSERT_EQ(reactor.pending(), 1U);
+
+  int const client = ::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+  ASSERT_GE(client, 0);
+  ASSERT_EQ(
+      ::connect(client, reinterpret_cast<sockaddr*>(&address), sizeof(address)),
+      0);
+  ASSERT_EQ(::write(client, "ping", 4), 4);
+
+  reactor.run();
+  ASSERT_GE(accepted, 0);
+  ASSERT_EQ(std::string(buffer, sizeof(buffer)), "ping");
+
+  reactor.release(accepted);
+  reactor.release(listener);
+  ::close(accepted);
+  ::close(client);
+  ::close(listener);
+}
+
+TEST(reactor_tests, are_cancelled_on_release) {
+  cti::io::reactor reactor;
+  socket_pair sockets;
+
+  char buffer[8];
+  bool cancelled = false;
+  reactor.async_read_some(sockets.first(), buffer, sizeof(buffer))
+      .fail([&](cti::error_type error) {
+        EXPECT_TRUE(bool(error));
+        cancelled = true;
+      });
+
+  ASSERT_EQ(reactor.pending(), 1U);
+  reactor.release(sockets.first());
+  ASSERT_TRUE(cancelled);
+  ASSERT_EQ(reactor.pending(), 0U);
+}
+
+TEST(reactor_tests, are_rejected_on_failure) {
+  cti::io::reactor reactor;
+
+  char buffer[8];
+  bool rejected = false;
+  reactor.async_read_some(-1, buffer, sizeof(buffer))
+      .fail([&](cti::error_type error) {
+        EXPECT_TRUE(bool(error));
+        rejected = true;
+      });
+
+  ASSERT_TRUE(rejected);
+}
+
+TEST(reactor_tests, are_usable_as_executor) {
+  cti::io::reactor reactor;
+
+  std::thread::id const reactor_thread = std::this_thread::get_id();
+  std::thread::id invoked_on;
+  bool finished = false;
+
+  std::thread worker;
+  cti::make_continuable<int>([&](auto&& promise) {
+    worker = std::thread(
+        [promise = std::forward<decltype(promise)>(promise)]() mutable {
+          promise.set_value(42);
+        });
+  }).then(
+      [&](int value) {
+        EXPECT_EQ(value, 42);
+        invoked_on = std::this_thread::get_id();
+        finished = true;
+      },
+      reactor.executor());
+
+  while (!finished) {
+    reactor.run_once();
+  }
+  worker.join();
+  ASSERT_EQ(invoked_on, reactor_thread);
+}
+
+#ifndef CONTINUABLE_WITH_NO_EXCEPTIONS
+TEST(reactor_tests, keep_the_remaining_work_when_work_throws) {
+  cti::io::reactor reactor;
+
+  std::vector<int> invoked;
+  reactor.post([&] {
+    invoked.push_back(0);
+    throw std::runtime_error("work failed");
+  });
+  reactor.post([&] { invoked.push_back(1); });
+
+  ASSERT_THROW(reactor.run(), std::runtime_error);
+  ASSERT_EQ(invoked, std::vector<int>{0});
+
+  // The failed work isn't invoked again
+  reactor.post([&] { invoked.push_back(2); });
+  reactor.run();
+  ASSERT_EQ(invoked, (std::vector<int>{0, 1, 2}));
+}
+#endif // CONTINUABLE_WITH_NO_EXCEPTIONS
+
+TEST(reactor_tests, receive_datagrams_in_batches) {
+  cti::io::reactor reactor;
+  loopback_socket sender;
+  loopback_socket receiver;
+
+  std::size_t const count = 48;
+  std::vector<std::string> payloads;
+  for (std::size_t i = 0; i < count; ++i) {
+    payloads.push_back("datagram " + std::to_string(i));
+  }
+
+  cti::io::datagram_batch received(32);
+  std::vector<std::string> receptions;
+  std::size_t batches = 0;
+  std::function<void()> receive = [&] {
+    reactor.async_receive_batch(receiver.fd(), received)
+        .then([&](std::size_t size) {
+          ASSERT_EQ(size, received.size());
+          ++batches;
+          for (std::size_t i = 0; i < size; ++i) {
+            ASSERT_FALSE(received[i].truncated());
+            ASSERT_EQ(received[i].address_size(), sender.address_size());
+            cti::io::span payload = received[i].data();
+            receptions.emplace_back(payload.begin(), payload.end());
+          }
+          if (receptions.size() < count) {
+            receive();
+          }
+        });
+  };
+
+  // The receive would block and is suspended until datagrams arrive
+  receive();
+  ASSERT_EQ(reactor.pending(), 1U);
+
+  cti::io::datagram_batch sent(count);
+  for (std::string const& payload : payloads) {
+    ASSERT_TRUE(sent.push(cti::io::span(payload.data(), payload.size()),
+                          receiver.address(), receiver.address_size()));
+  }
+  ASSERT_FALSE(sent.push(cti::io::span()));
+
+  reactor.async_send_batch(sender.fd(), sent)
+      .then([&](std::size_t size) { EXPECT_EQ(size, count); });
+
+  reactor.run();
+  ASSERT_EQ(receptions, payloads);
+  // The datagrams arrived in fewer batches than datagrams
+  ASSERT_LT(batches, count);
+}
+
+TEST(reactor_tests, truncate_long_datagrams) {
+  cti::io::reactor reactor;
+  loopback_socket sender;
+  loopback_socket receiver;
+
+  std::string const payload(100, 'x');
+  ASSERT_EQ(::sendto(sender.fd(), payload.data(), payload.size(), 0,
+                     receiver.address(), receiver.address_size()),
+            100);
+
+  cti::io::datagram_batch received(4, 10);
+  bool finished = false;
+  reactor.async_receive_batch(receiver.fd(), received)
+      .then([&](std::size_t size) {
+        ASSERT_EQ(size, 1U);
+        EXPECT_TRUE(received[0].truncated());
+        EXPECT_EQ(received[0].data().size(), 10U);
+        finished = true;
+      });
+
+  reactor.run();
+  ASSERT_TRUE(finished);
+}
+
+#endif // CONTINUABLE_HAS_EPOLL
@@ -0,0 +1,145 @@
+
+/*
+  Copyright(c) 2015 - 2018 Denis Blank <denis.blank at outlook dot com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files(the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions :
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+**/
+#include <chrono>
+#include <cstddef>
+#include <random>
+#include <vector>
+
+#include <continuable/continuable-timer.hpp>
+
+#include "test-continuable.hpp"
+
+using std::chrono::milliseconds;
+using std::chrono::nanoseconds;
+using std::chrono::seconds;
+
+TEST(timer_wheel_tests, expire_in_order) {
+  cti::timer_wheel timers(milliseconds(1));
+  auto const start = cti::timer_wheel::clock::now();
+
+  std::vector<int> expired;
+  timers.at(start + milliseconds(300)).then([&] { expired.push_back(2); });
+  timers.at(start + milliseconds(10)).then([&] { expired.push_back(1); });
+  timers.at(start + seconds(70)).then([&] { expired.push_back(3); });
+  ASSERT_EQ(timers.pending(), 3U);
+
+  ASSERT_EQ(timers.advance(start + milliseconds(9)), 0U);
+  ASSERT_EQ(timers.advance(start + milliseconds(11)), 1U);
+  ASSERT_EQ(timers.advance(start + milliseconds(299)), 0U);
+  ASSERT_EQ(timers.advance(start + milliseconds(301)), 1U);
+  ASSERT_EQ(timers.advance(start + seconds(69)), 0U);
+  ASSERT_EQ(timers.advance(start + seconds(71)), 1U);
+
+  ASSERT_EQ(expired, (std::vector<int>{1, 2, 3}));
+  ASSERT_EQ(timers.pending(), 0U);
+}
+
+TEST(timer_wheel_tests, never_expire_early) {
+  cti::timer_wheel timers(milliseconds(1));
+  auto const start = cti::timer_wheel::clock::now();
+
+  std::mt19937 generator(7);
+  std::uniform_int_distribution<int> distribution(1, 1 << 22);
+
+  std::size_t const count = 10000;
+  std::vector<milliseconds> deadlines(count);
+  std::vector<milliseconds> expired_at(count, milliseconds(-1));
+  milliseconds now(0);
+  for (std::size_t i = 0; i < count; ++i) {
+    deadlines[i] = milliseconds(distribution(generator));
+    timers.at(start + deadlines[i]).then([&, i] { expired_at[i] = now; });
+  }
+
+  std::size_t expired = 0;
+  std::uniform_int_distribution<int> steps(1, 5000);
+  while (timers.pending()) {
+    now += milliseconds(steps(generator));
+    expired += timers.advance(start + now);
+  }
+
+  ASSERT_EQ(expired, count);
+  for (std::size_t i = 0; i < count; ++i) {
+    // The timer expires in the first step which passed its deadline
+    ASSERT_GE(expired_at[i], deadlines[i]);
+    ASSERT_LT(expired_at[i] - deadlines[i], milliseconds(5000));
+  }
+}
+
+TEST(timer_wheel_tests, expire_beyond_the_range_of_the_wheel) {
+  cti::timer_wheel timers(nanoseconds(1));
+  auto const start = cti::timer_wheel::clock::now();
+
+  bool expired = false;
+  timers.at(start + seconds(10)).then([&] { expired = true; });
+
+  ASSERT_EQ(timers.advance(start + seconds(5)), 0U);
+  ASSERT_EQ(timers.advance(start + seconds(10) - milliseconds(1)), 0U);
+  ASSERT_FALSE(expired);
+  ASSERT_EQ(timers.advance(start + seconds(10) + milliseconds(1)), 1U);
+  ASSERT_TRUE(expired);
+}
+
+TEST(timer_wheel_tests, are_cancelable) {
+  cti::timer_wheel timers;
+  auto const start = cti::timer_wheel::clock::now();
+
+  cti::timer_wheel::timer handle;
+  bool cancelled = false;
+  timers.at(start + seconds(1), handle).fail([&](cti::error_type error) {
+    EXPECT_TRUE(bool(error));
+    cancelled = true;
+  });
+
+  bool expired = false;
+  timers.at(start + seconds(1)).then([&] { expired = true; });
+  ASSERT_EQ(timers.pending(), 2U);
+
+  ASSERT_TRUE(timers.cancel(handle));
+  ASSERT_TRUE(cancelled);
+  ASSERT_FALSE(timers.cancel(handle));
+  ASSERT_EQ(timers.pending(), 1U);
+
+  ASSERT_EQ(timers.advance(start + seconds(2)), 1U);
+  ASSERT_TRUE(expired);
+  ASSERT_FALSE(timers.cancel(handle));
+}
+
+TEST(timer_wheel_tests, expire_timers_started_on_expiry) {
+  cti::timer_wheel timers(milliseconds(1));
+
+  std::size_t expired = 0;
+  timers.after(milliseconds(1))
+      .then([&] {
+        ++expired;
+        return timers.after(milliseconds(0));
+      })
+      .then([&] {
+        ++expired;
+        return timers.after(milliseconds(2));
+      })
+      .then([&] { ++expired; });
+
+  timers.run();
+  ASSERT_EQ(expired, 3U);
+  ASSERT_EQ(timers.pending(), 0U);
+}
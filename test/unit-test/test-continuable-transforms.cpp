@@ -21,6 +21,9 @@
   SOFTWARE.
 **/
 
+#include <chrono>
+#include <thread>
+
 #include <continuable/continuable-transforms.hpp>
 
 #include "test-continuable.hpp"
@@ -68,6 +71,72 @@ TYPED_TEST(single_dimension_tests, are_convertible_to_futures) {
   }
 }
 
+TYPED_TEST(single_dimension_tests, are_waitable) {
+  {
+    auto result = this->supply().apply(cti::transforms::wait());
+    ASSERT_TRUE(result.is_value());
+  }
+
+  {
+    auto result = cti::sync_wait(this->supply().then([] {
+      // ...
+      return 0xFD;
+    }));
+
+    ASSERT_TRUE(result.is_value());
+    EXPECT_EQ(result.get_value(), 0xFD);
+  }
+
+  {
+    auto canary = std::make_tuple(0xFD, 0xF5);
+
+    auto result = cti::sync_wait(this->supply().then([&] {
+      // ...
+      return canary;
+    }));
+
+    ASSERT_TRUE(result.is_value());
+    EXPECT_EQ(result.get_value(), canary);
+  }
+
+  {
+    auto result =
+        cti::sync_wait(this->supply_exception(supply_test_exception()));
+    ASSERT_TRUE(result.is_exception());
+  }
+}
+
+TEST(wait_tests, are_waitable_across_threads) {
+  for (int i = 0; i < 64; ++i) {
+    std::thread resolver;
+    auto result =
+        cti::sync_wait(cti::make_continuable<int>([&, i](auto&& promise) {
+          resolver = std::thread([i, promise = std::forward<decltype(promise)>(
+                                         promise)]() mutable {
+            if (i % 2) {
+              // Give the waiting thread the chance to be parked
+              std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+            promise.set_value(i);
+          });
+        }));
+    resolver.join();
+
+    ASSERT_TRUE(result.is_value());
+    EXPECT_EQ(result.get_value(), i);
+  }
+}
+
+TEST(wait_tests, report_dropped_promises) {
+  auto result = cti::sync_wait(cti::make_continuable<int>([](auto&& promise) {
+    // The promise is dropped without being resolved
+    auto dropped = std::forward<decltype(promise)>(promise);
+    (void)dropped;
+  }));
+
+  ASSERT_TRUE(result.is_exception());
+}
+
 TYPED_TEST(single_dimension_tests, are_flattable) {
   auto continuation = this->supply_exception(supply_test_exception())
                           .apply(cti::transforms::flatten());
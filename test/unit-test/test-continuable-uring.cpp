@@ -0,0 +1,105 @@
+
+/*
+  Copyright(c) 2015 - 2018 Denis Blank <denis.blank at outlook dot com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files(the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions :
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+**/
+
+#include <continuable/detail/features.hpp>
+
+#ifdef CONTINUABLE_HAS_IO_URING
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+#include <continuable/continuable-uring.hpp>
+
+#include "test-continuable.hpp"
+
+TEST(uring_tests, read_what_was_written) {
+  cti::io::uring ring;
+  temporary_file file;
+
+  std::string const content = "hello io_uring";
+  std::string read(content.size(), '\0');
+  bool finished = false;
+
+  ring.write_at(file.fd(), content.data(), content.size(), 0)
+      .then([&](std::size_t written) {
+        EXPECT_EQ(written, content.size());
+        return ring.fsync(file.fd());
+      })
+      .then([&] { return ring.read_at(file.fd(), &read[0], read.size(), 0); })
+      .then([&](std::size_t count) {
+        EXPECT_EQ(count, content.size());
+        finished = true;
+      });
+
+  ASSERT_EQ(ring.pending(), 1U);
+  ring.run();
+  ASSERT_TRUE(finished);
+  ASSERT_EQ(read, content);
+  ASSERT_EQ(ring.pending(), 0U);
+}
+
+TEST(uring_tests, batch_more_operations_than_entries) {
+  cti::io::uring ring(8);
+  temporary_file file;
+
+  std::size_t const count = 1000;
+  std::vector<char> content(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    content[i] = static_cast<char>(i);
+  }
+  ASSERT_EQ(::pwrite(file.fd(), content.data(), count, 0),
+            static_cast<ssize_t>(count));
+
+  std::vector<char> read(count);
+  std::size_t completed = 0;
+  for (std::size_t i = 0; i < count; ++i) {
+    ring.read_at(file.fd(), &read[i], 1, i).then([&](std::size_t bytes) {
+      EXPECT_EQ(bytes, 1U);
+      ++completed;
+    });
+  }
+
+  ring.run();
+  ASSERT_EQ(completed, count);
+  ASSERT_EQ(read, content);
+}
+
+TEST(uring_tests, are_rejected_on_failure) {
+  cti::io::uring ring;
+
+  char buffer[8];
+  bool rejected = false;
+  ring.read_at(-1, buffer, sizeof(buffer), 0)
+      .fail([&](cti::error_type error) {
+        EXPECT_TRUE(bool(error));
+        rejected = true;
+      });
+
+  ring.run();
+  ASSERT_TRUE(rejected);
+}
+
+#endif // CONTINUABLE_HAS_IO_URING
@@ -0,0 +1,147 @@
+
+/*
+  Copyright(c) 2015 - 2018 Denis Blank <denis.blank at outlook dot com>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files(the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions :
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+**/
+#include <continuable/detail/features.hpp>
+
+#ifdef CONTINUABLE_HAS_EPOLL
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include <sys/inotify.h>
+
+#include <continuable/continuable-reactor.hpp>
+#include <continuable/continuable-types.hpp>
+#include <continuable/continuable-watcher.hpp>
+
+#include "test-continuable.hpp"
+
+using cti::io::file_change;
+
+TEST(file_watcher_tests, coalesce_bursts_per_path) {
+  cti::io::reactor reactor;
+  cti::io::file_watcher watcher(reactor, std::chrono::milliseconds(20));
+  temporary_directory directory;
+  watcher.watch(directory.path());
+
+  std::vector<file_change> received;
+  watcher.next().then([&](std::vector<file_change> changes) {
+    received = std::move(changes);
+  });
+  ASSERT_EQ(reactor.pending(), 1U);
+
+  std::string const first = directory.append("first", "a");
+  directory.append("first", "b");
+  std::string const second = directory.append("second", "c");
+  directory.append("first", "d");
+
+  reactor.run();
+  ASSERT_EQ(received.size(), 2U);
+  EXPECT_EQ(received[0].path, first);
+  EXPECT_TRUE(received[0].events & IN_CREATE);
+  EXPECT_TRUE(received[0].events & IN_MODIFY);
+  EXPECT_TRUE(received[0].events & IN_CLOSE_WRITE);
+  EXPECT_EQ(received[1].path, second);
+}
+
+TEST(file_watcher_tests, deliver_later_changes_in_the_next_window) {
+  cti::io::reactor reactor;
+  cti::io::file_watcher watcher(reactor, std::chrono::milliseconds(5));
+  temporary_directory directory;
+  watcher.watch(directory.path());
+
+  std::vector<std::vector<file_change>> windows;
+  watcher.next().then([&](std::vector<file_change> changes) {
+    windows.push_back(std::move(changes));
+    directory.append("second", "b");
+
+    watcher.next().then([&](std::vector<file_change> changes) {
+      windows.push_back(std::move(changes));
+    });
+  });
+
+  directory.append("first", "a");
+  reactor.run();
+
+  ASSERT_EQ(windows.size(), 2U);
+  ASSERT_EQ(windows[0].size(), 1U);
+  EXPECT_EQ(windows[0][0].path, directory.path() + "/first");
+  ASSERT_EQ(windows[1].size(), 1U);
+  EXPECT_EQ(windows[1][0].path, directory.path() + "/second");
+}
+
+TEST(file_watcher_tests, queue_changes_while_nobody_waits) {
+  cti::io::reactor reactor;
+  cti::io::file_watcher watcher(reactor, std::chrono::milliseconds(0));
+  temporary_directory directory;
+  std::string const file = directory.append("file", "a");
+  watcher.watch(file);
+
+  // Nothing is read while no continuation waits
+  directory.append("file", "b");
+  ASSERT_EQ(reactor.pending(), 0U);
+
+  std::vector<file_change> received;
+  watcher.next().then([&](std::vector<file_change> changes) {
+    received = std::move(changes);
+  });
+  reactor.run();
+
+  ASSERT_EQ(received.size(), 1U);
+  EXPECT_EQ(received[0].path, file);
+  EXPECT_TRUE(received[0].events & IN_MODIFY);
+}
+
+TEST(file_watcher_tests, report_removed_watches) {
+  cti::io::reactor reactor;
+  cti::io::file_watcher watcher(reactor);
+  temporary_directory directory;
+  std::string const file = directory.append("file", "a");
+  watcher.unwatch(watcher.watch(file));
+
+  std::vector<file_change> received;
+  watcher.next().then([&](std::vector<file_change> changes) {
+    received = std::move(changes);
+  });
+  reactor.run();
+
+  ASSERT_EQ(received.size(), 1U);
+  EXPECT_EQ(received[0].path, file);
+  EXPECT_TRUE(received[0].events & IN_IGNORED);
+}
+
+TEST(file_watcher_tests, are_cancelled_on_destruction) {
+  cti::io::reactor reactor;
+  bool cancelled = false;
+  {
+    cti::io::file_watcher watcher(reactor);
+    watcher.next()
+        .then([](std::vector<file_change>) { FAIL(); })
+        .fail([&](cti::error_type) { cancelled = true; });
+    ASSERT_FALSE(cancelled);
+  }
+  ASSERT_TRUE(cancelled);
+  ASSERT_EQ(reactor.pending(), 0U);
+}
+
+#endif // CONTINUABLE_HAS_EPOLL
@@ -25,10 +25,19 @@
 #define TEST_CONTINUABLE_HPP__
 
 #include <cassert>
+#include <cstdlib>
 
 #include <gtest/gtest.h>
 
 #include <functional>
+#include <string>
+#include <vector>
+
+#if defined(__unix__)
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
 #include <continuable/continuable-base.hpp>
 #include <continuable/continuable-testing.hpp>
@@ -241,4 +250,92 @@ inline std::error_condition supply_test_exception() {
 }
 #endif
 
+#if defined(__unix__)
+/// A temporary file with the given content which is removed on destruction
+class temporary_file {
+  std::string path_;
+  int fd_;
+
+public:
+  explicit temporary_file(std::string const& content = "")
+      : path_("/tmp/continuable-XXXXXX") {
+    fd_ = ::mkstemp(&path_[0]);
+    EXPECT_NE(fd_, -1);
+    EXPECT_EQ(::write(fd_, content.data(), content.size()),
+              static_cast<ssize_t>(content.size()));
+  }
+  ~temporary_file() {
+    ::close(fd_);
+    ::unlink(path_.c_str());
+  }
+
+  int fd() const noexcept {
+    return fd_;
+  }
+  char const* path() const noexcept {
+    return path_.c_str();
+  }
+};
+
+/// A temporary directory which is removed together with the files
+/// and directories created inside of it
+class temporary_directory {
+  std::string path_;
+  std::vector<std::string> files_;
+  std::vector<std::string> directories_;
+
+public:
+  temporary_directory() : path_("/tmp/continuable-XXXXXX") {
+    EXPECT_NE(::mkdtemp(&path_[0]), nullptr);
+  }
+  ~temporary_directory() {
+    for (std::string const& file : files_) {
+      ::unlink(file.c_str());
+    }
+    for (auto itr = directories_.rbegin(); itr != directories_.rend();
+         ++itr) {
+      ::rmdir(itr->c_str());
+    }
+    ::rmdir(path_.c_str());
+  }
+
+  std::string const& path() const noexcept {
+    return path_;
+  }
+
+  /// Creates the directory with the given name
+  void directory(std::string const& name) {
+    std::string const path = path_ + "/" + name;
+    EXPECT_EQ(::mkdir(path.c_str(), 0700), 0);
+    directories_.push_back(path);
+  }
+  /// Creates the file with the given name and content
+  std::string file(std::string const& name, std::string const& content = "") {
+    return write(name, content, O_TRUNC);
+  }
+  /// Appends the content to the file with the given name
+  std::string append(std::string const& name, std::string const& content) {
+    return write(name, content, O_APPEND);
+  }
+  /// Creates a symbolic link with the given name pointing to the target
+  void link(std::string const& name, std::string const& target) {
+    std::string const path = path_ + "/" + name;
+    EXPECT_EQ(::symlink(target.c_str(), path.c_str()), 0);
+    files_.push_back(path);
+  }
+
+private:
+  std::string write(std::string const& name, std::string const& content,
+                    int flags) {
+    std::string const path = path_ + "/" + name;
+    int const fd = ::open(path.c_str(), O_WRONLY | O_CREAT | flags, 0600);
+    EXPECT_EQ(::write(fd, content.data(), content.size()),
+              static_cast<ssize_t>(content.size()));
+    ::close(fd);
+    files_.push_back(path);
+    return path;
+  }
+};
+#endif // defined(__unix__)
+
 #endif // TEST_CONTINUABLE_HPP__